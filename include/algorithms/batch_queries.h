@@ -0,0 +1,105 @@
+#pragma once
+#include <cstdint>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <vector>
+
+#include "algorithms/dijkstras.h"
+#include "core/csr_graph.h"
+#include "core/graph.h"
+
+/**
+ * @brief A single query read from a batch query file. Each line of the file
+ * holds one query in one of these forms, where addresses are hex strings:
+ *
+ *   dist <source> <target>   the shortest path distance between two vertices
+ *   knn <source> <k>         the k vertices closest to the source
+ *   sssp <source>            the distance to every vertex reachable from the
+ *                            source
+ *
+ * Blank lines and lines starting with '#' are skipped.
+ */
+struct BatchQuery {
+  /**
+   * @brief The kinds of queries a batch query file can hold.
+   */
+  enum class Type { DISTANCE, NEAREST, SINGLE_SOURCE };
+
+  /**
+   * @brief The kind of this query.
+   */
+  Type type;
+
+  /**
+   * @brief The line of the query file this query was read from, starting at 
+   * 1, which identifies the query in the output.
+   */
+  size_t line;
+
+  /**
+   * @brief The ID of the vertex to search from.
+   */
+  uint32_t source;
+
+  /**
+   * @brief The ID of the vertex to find the distance to. Only used by 
+   * DISTANCE queries.
+   */
+  uint32_t target;
+
+  /**
+   * @brief The number of closest vertices to find. Only used by NEAREST 
+   * queries.
+   */
+  uint32_t k;
+};
+
+/**
+ * @brief Written in the distance column of a DISTANCE query whose target is
+ * not reachable from its source.
+ */
+static const char UNREACHABLE_DISTANCE[] = "unreachable";
+
+/**
+ * @brief Read every query from a batch query file, looking up the addresses
+ * they name in the passed graph.
+ *
+ * @param in a std::istream to read queries from.
+ * @param g a Graph to look up the vertices named by the queries in.
+ * @param queries a std::vector<BatchQuery> to append the valid queries to.
+ * @param errors a std::vector<std::string> to append a message to for every
+ * line that is malformed or names an address that is not in the graph. Those
+ * lines are skipped.
+ */
+void parse_batch_queries(std::istream& in, const Graph& g,
+                         std::vector<BatchQuery>& queries,
+                         std::vector<std::string>& errors);
+
+/**
+ * @brief Answer every passed query and write the results to the passed stream
+ * as CSV rows of "query,address,distance", where query is the line the query
+ * was read from and address is the vertex the distance is to. DISTANCE 
+ * queries write one row, NEAREST queries write up to k rows, and 
+ * SINGLE_SOURCE queries write one row per reachable vertex, closest first.
+ *
+ * DISTANCE queries between vertices that are not connected write 
+ * UNREACHABLE_DISTANCE in place of the distance.
+ *
+ * Queries run in parallel, each thread reusing its own traversal workspaces
+ * for every query it answers. The results of a query are written as soon as 
+ * it and every query before it are answered, so the output matches that of 
+ * answering the queries one at a time. Threads only run ahead of the oldest 
+ * unanswered query by a bounded number of queries and bytes of results, which
+ * bounds the memory held by results that wait to be written.
+ *
+ * @param g a CSRGraph to answer the queries on.
+ * @param queries a std::vector<BatchQuery> of the queries to answer.
+ * @param out a std::ostream to write the results to.
+ * @param num_threads an int indicating the number of threads to use.
+ * @param queue a QueueType indicating the priority queue used by searches.
+ */
+void run_batch_queries(const CSRGraph& g, 
+                       const std::vector<BatchQuery>& queries,
+                       std::ostream& out, int num_threads=1,
+                       QueueType queue=QueueType::AUTO);
@@ -1,37 +1,60 @@
 #pragma once
+#include <cstdint>
+#include <vector>
+
+#include "algorithms/component_census.h"
+#include "algorithms/subgraph_view.h"
+#include "core/csr_graph.h"
 #include "core/vertex.h"
 #include "core/graph.h"
 
 /**
  * @brief Perform breadth first search upon all connected compontents within the
- * passed graph. 
+ * passed graph. Every vertex is marked as explored afterwards.
+ *
+ * Every search here is a direction-optimizing BFS over the dense vertex IDs
+ * of the graph, which expands small frontiers top-down and switches to
+ * bottom-up steps, where each unexplored vertex looks for a parent in a 
+ * frontier bitmap, once the frontier covers a large share of the graph.
  * 
  * @param g a Graph* to perform the search upon.
+ * @param mark_edges a bool indicating whether or not every edge should also
+ * be marked as explored, which costs a pass over all edges.
  * @return an int indicating the number of connected components in the graph.
  */
-int bfs(Graph* g);
+int bfs(Graph* g, bool mark_edges=false);
 
 /** 
- * @brief Perform breadth first search upon all connected compontents within the
- * passed graph starting at the passed Vertex.
+ * @brief Perform breadth first search upon the connected compontent of the
+ * passed graph containing the passed Vertex, marking every vertex reached as
+ * explored.
  * 
  * @param g a Graph* to perform the search upon.
  * @param start the Vertex* to begin the search from.
+ * @param mark_edges a bool indicating whether or not the edges of every 
+ * vertex reached should also be marked as explored.
  */
-int bfs(Graph* g, Vertex* start);
+int bfs(Graph* g, Vertex* start, bool mark_edges=false);
 
 /**
- * @brief Perform breadth first search upon all connected compontents within the
- * passed graph and print out the CPU running time of the algorithm along with
- * sanity checks to indicate that the search visits all vertices and edges.
+ * @brief Find the connected components of the passed graph with 
+ * connected_components, take their census, and print out the running time
+ * along with a summary of the largest components. Optionally also runs 
+ * sanity checks to indicate that every vertex and edge was accounted for, 
+ * which cost another pass over every edge.
  * 
- * @param g a Graph* to perform the search upon.
+ * @param g a Graph to take the census of.
+ * @param csr the CSRGraph of g to find the components of.
+ * @param num_threads an int indicating the number of threads to use.
+ * @param validate a bool indicating whether or not to run the sanity checks.
+ * @return a ComponentCensus of every component of the graph.
  */
-void run_bfs(Graph* g);
+ComponentCensus run_bfs(const Graph& g, const CSRGraph& csr, 
+                        int num_threads=1, bool validate=false);
 
 /**
  * @brief Find the largest connected component in the passed graph by running a
- * BFS traversal on each component in the graph. 
+ * BFS traversal on each component in the graph. The graph is not modified.
  * 
  * @param g a Graph* to perform the search upon.
  * @return a std::vector<Vertex*> containing the Vertex* that make up the 
@@ -51,3 +74,49 @@ std::vector<Vertex*> find_largest_component(Graph* g);
  * largest connected component of the passed graph.
  */
 std::vector<Vertex*> find_largest_component(Graph* g, Vertex* start);
+
+/**
+ * @brief Perform breadth first search upon all connected compontents within the
+ * passed compressed graph. The graph is not modified; the explored state of 
+ * each vertex is tracked in a local bitmap indexed by vertex ID.
+ * 
+ * @param g a CSRGraph to perform the search upon.
+ * @return an int indicating the number of connected components in the graph.
+ */
+int bfs(const CSRGraph& g);
+
+/**
+ * @brief Perform breadth first search upon all connected compontents of the
+ * subgraph of the passed compressed graph seen through the passed view, 
+ * without materializing the subgraph. Edges leaving the view are skipped.
+ * 
+ * @param g the CSRGraph the view was taken of.
+ * @param view a SubgraphView of g to perform the search upon.
+ * @return an int indicating the number of connected components in the 
+ * subgraph.
+ */
+int bfs(const CSRGraph& g, const SubgraphView& view);
+
+/**
+ * @brief Find the largest connected component in the passed compressed graph 
+ * by running a BFS traversal on each component in the graph. 
+ * 
+ * @param g a CSRGraph to perform the search upon.
+ * @return a std::vector<uint32_t> containing the IDs of the vertices that make
+ * up the largest connected component of the passed graph.
+ */
+std::vector<uint32_t> find_largest_component(const CSRGraph& g);
+
+/**
+ * @brief Label every vertex of the passed compressed graph with the connected
+ * component it belongs to by running a BFS traversal on each component.
+ * Components are numbered from 0 in order of their lowest vertex ID.
+ *
+ * @param g a CSRGraph to perform the search upon.
+ * @param sizes a std::vector<uint32_t> that is filled with the number of 
+ * vertices in each component, indexed by component.
+ * @return a std::vector<uint32_t> holding the component of every vertex, 
+ * indexed by vertex ID.
+ */
+std::vector<uint32_t> label_components(const CSRGraph& g, 
+                                       std::vector<uint32_t>& sizes);
@@ -0,0 +1,88 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief A fixed size set of vertex IDs stored as one bit per vertex. Compared
+ * to an array of flags, a bitmap packs 64 vertices into each word, so sweeping
+ * over every vertex touches an eighth of the memory and whole words of
+ * members or non-members can be skipped at once.
+ */
+class Bitmap {
+  public:
+    /**
+     * @brief Construct a bitmap for the passed number of vertices with no bits
+     * set.
+     *
+     * @param size a uint32_t indicating the number of vertices.
+     */
+    explicit Bitmap(uint32_t size = 0)
+      : words_((static_cast<uint64_t>(size) + 63) / 64, 0), size_(size) { }
+
+    /**
+     * @brief Get the number of vertices this bitmap holds a bit for.
+     *
+     * @return a uint32_t indicating the number of vertices.
+     */
+    uint32_t size() const { return size_; }
+
+    /**
+     * @brief Check whether the bit of the passed vertex is set.
+     *
+     * @param v a uint32_t indicating the ID of a vertex.
+     * @return true if the bit IS set.
+     * @return false if the bit is NOT set.
+     */
+    bool get(uint32_t v) const { return (words_[v / 64] >> (v % 64)) & 1; }
+
+    /**
+     * @brief Set the bit of the passed vertex.
+     *
+     * @param v a uint32_t indicating the ID of a vertex.
+     */
+    void set(uint32_t v) { words_[v / 64] |= uint64_t(1) << (v % 64); }
+
+    /**
+     * @brief Clear every bit.
+     */
+    void clear() { std::fill(words_.begin(), words_.end(), 0); }
+
+    /**
+     * @brief Get the word holding the bits of vertices [64 * i, 64 * i + 64).
+     * Bits past the last vertex are never set.
+     *
+     * @param i a uint32_t indicating the index of the word.
+     * @return a uint64_t holding the bits of 64 vertices.
+     */
+    uint64_t word(uint32_t i) const { return words_[i]; }
+
+    /**
+     * @brief Get the number of words in the bitmap.
+     *
+     * @return a uint32_t indicating the number of words.
+     */
+    uint32_t numWords() const { return words_.size(); }
+
+    /**
+     * @brief Exchange the bits of this bitmap with those of another bitmap of
+     * the same size in constant time.
+     *
+     * @param other the Bitmap to swap with.
+     */
+    void swap(Bitmap& other) {
+      words_.swap(other.words_);
+      std::swap(size_, other.size_);
+    }
+  private:
+    /**
+     * @brief The bits of every vertex, 64 to a word.
+     */
+    std::vector<uint64_t> words_;
+
+    /**
+     * @brief The number of vertices.
+     */
+    uint32_t size_;
+};
@@ -0,0 +1,102 @@
+#pragma once
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief A monotone min-priority queue of vertex IDs keyed by integer distance
+ * for graphs whose largest edge weight C is small, also known as Dial's
+ * algorithm. While Dijkstra's algorithm settles vertices at distance d, every
+ * distance in the queue lies in [d, d + C], so C + 1 buckets used as a
+ * circular array are enough to hold an entry for each distance. Pushing is a
+ * single append, and popping scans forward to the next non-empty bucket, so a
+ * search costs O(E + D) where D is the largest distance found.
+ *
+ * Like the lazy binary heap, improving the distance of a vertex pushes a new
+ * entry, so callers must skip vertices that were already settled.
+ */
+class BucketQueue {
+  public:
+    /**
+     * @brief The largest edge weight a BucketQueue is used for. Graphs with
+     * heavier edges would need too many buckets, and a RadixHeap is used
+     * instead.
+     */
+    static constexpr uint64_t MAX_WEIGHT = 4096;
+
+    /**
+     * @brief Construct an empty queue for graphs with edge weights of at most
+     * max_weight.
+     *
+     * @param max_weight a uint64_t indicating the largest edge weight.
+     */
+    explicit BucketQueue(uint64_t max_weight = 0)
+      : buckets_(max_weight + 1), current_(0), size_(0) { }
+
+    /**
+     * @brief Check whether the queue holds no entries.
+     */
+    bool empty() const { return size_ == 0; }
+
+    /**
+     * @brief Get the entry with the smallest distance in the queue. The queue
+     * must not be empty.
+     *
+     * @return a std::pair of the smallest distance and the ID of its vertex.
+     */
+    const std::pair<uint64_t, uint32_t>& top() {
+      while (buckets_[current_ % buckets_.size()].empty()) ++current_;
+      return buckets_[current_ % buckets_.size()].back();
+    }
+
+    /**
+     * @brief Add an entry for the passed vertex with the passed distance,
+     * which must lie in [d, d + C] where d is the last distance returned by
+     * top.
+     *
+     * @param v a uint32_t indicating the ID of a vertex.
+     * @param distance a uint64_t indicating the distance of the vertex.
+     */
+    void pushOrDecrease(uint32_t v, uint64_t distance) {
+      buckets_[distance % buckets_.size()].push_back({distance, v});
+      ++size_;
+    }
+
+    /**
+     * @brief Remove the entry with the smallest distance from the queue. The
+     * queue must not be empty.
+     */
+    void pop() {
+      top();
+      buckets_[current_ % buckets_.size()].pop_back();
+      --size_;
+    }
+
+    /**
+     * @brief Remove every entry and restart at distance 0 so that a new search
+     * can begin.
+     */
+    void clear() {
+      if (size_ != 0) {
+        for (std::vector<std::pair<uint64_t, uint32_t>>& b : buckets_) b.clear();
+      }
+
+      current_ = 0;
+      size_ = 0;
+    }
+  private:
+    /**
+     * @brief The entries with distance d are kept in bucket d % (C + 1).
+     */
+    std::vector<std::vector<std::pair<uint64_t, uint32_t>>> buckets_;
+
+    /**
+     * @brief The last distance returned by top.
+     */
+    uint64_t current_;
+
+    /**
+     * @brief The number of entries in the queue.
+     */
+    uint64_t size_;
+};
@@ -0,0 +1,189 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <utility>
+#include <vector>
+
+#include "algorithms/connected_components.h"
+#include "core/graph.h"
+
+/**
+ * @brief The header of a component census file written by
+ * ComponentCensus::save. The header is followed by these arrays, each
+ * starting on an 8 byte boundary:
+ *
+ *   uint32_t num_vertices[num_components]
+ *   uint64_t num_edges[num_components]
+ *   uint64_t total_gas[num_components]
+ *   double   total_value[num_components]
+ */
+struct CensusHeader {
+  /**
+   * @brief Identifies the file as a component census. Always CENSUS_MAGIC.
+   */
+  char magic[8];
+
+  /**
+   * @brief The version of the component census file format.
+   */
+  uint32_t version;
+
+  /**
+   * @brief The size of this header in bytes. The first array begins here.
+   */
+  uint32_t header_size;
+
+  /**
+   * @brief The number of components in the census.
+   */
+  uint64_t num_components;
+
+  /**
+   * @brief Unused space reserved for future versions of the format.
+   */
+  uint64_t reserved[2];
+};
+
+/**
+ * @brief The magic bytes at the start of every component census file.
+ */
+static const char CENSUS_MAGIC[8] = {'G', 'T', 'H', 'C', 'E', 'N', 'S', '\0'};
+
+/**
+ * @brief The version of the component census file format written by this
+ * build.
+ */
+static const uint32_t CENSUS_VERSION = 1;
+
+/**
+ * @brief The number of vertices and edges and the total gas and value of the
+ * transactions of every connected component of a graph, taken in a single
+ * pass over its edges.
+ */
+class ComponentCensus {
+  public:
+    /**
+     * @brief Construct an empty census with no components.
+     */
+    ComponentCensus() = default;
+
+    /**
+     * @brief Take the census of the passed graph. Every edge is counted in the
+     * component of its endpoints.
+     *
+     * @param g a Graph to take the census of.
+     * @param components the Components of g, as found by connected_components
+     * on a CSRGraph of g.
+     * @return a ComponentCensus with one entry per component, numbered like
+     * the passed components.
+     */
+    static ComponentCensus take(const Graph& g, const Components& components);
+
+    /**
+     * @brief Get the number of components in the census.
+     *
+     * @return a uint32_t indicating the number of components.
+     */
+    uint32_t numComponents() const { return num_vertices_.size(); }
+
+    /**
+     * @brief Get the number of vertices in the passed component.
+     *
+     * @param c a uint32_t indicating a component.
+     * @return a uint32_t indicating the number of vertices.
+     */
+    uint32_t numVertices(uint32_t c) const { return num_vertices_[c]; }
+
+    /**
+     * @brief Get the number of edges in the passed component.
+     *
+     * @param c a uint32_t indicating a component.
+     * @return a uint64_t indicating the number of edges.
+     */
+    uint64_t numEdges(uint32_t c) const { return num_edges_[c]; }
+
+    /**
+     * @brief Get the total gas of the transactions in the passed component.
+     *
+     * @param c a uint32_t indicating a component.
+     * @return a uint64_t indicating the total gas.
+     */
+    uint64_t totalGas(uint32_t c) const { return total_gas_[c]; }
+
+    /**
+     * @brief Get the total value of the transactions in the passed component,
+     * in the same units as Edge::getValue.
+     *
+     * @param c a uint32_t indicating a component.
+     * @return a double indicating the total value.
+     */
+    double totalValue(uint32_t c) const { return total_value_[c]; }
+
+    /**
+     * @brief Count the components of every size.
+     *
+     * @return a std::vector of pairs of a component size and the number of
+     * components of that size, in order of increasing size.
+     */
+    std::vector<std::pair<uint32_t, uint32_t>> sizeHistogram() const;
+
+    /**
+     * @brief Get the components with the most vertices.
+     *
+     * @param k a size_t indicating the number of components to get.
+     * @return a std::vector<uint32_t> holding at most k components in order
+     * of decreasing size. Ties go to the lower numbered component.
+     */
+    std::vector<uint32_t> largest(size_t k) const;
+
+    /**
+     * @brief Write the census to a CSV file with one row per component.
+     * Existing files at the given path are overwritten.
+     *
+     * @param path a std::string indicating the path to write to.
+     * @return true if the file was written successfully.
+     * @return false if the file could not be opened or written.
+     */
+    bool saveCsv(const std::string& path) const;
+
+    /**
+     * @brief Write the census to a binary file laid out as described by
+     * CensusHeader. Existing files at the given path are overwritten.
+     *
+     * @param path a std::string indicating the path to write to.
+     * @return true if the file was written successfully.
+     * @return false if the file could not be opened or written.
+     */
+    bool save(const std::string& path) const;
+
+    /**
+     * @brief Read a census file written by `save`.
+     *
+     * @param path a std::string indicating the path of the file.
+     * @param census the ComponentCensus to fill.
+     * @return true if the census was read.
+     * @return false if the file is missing, is not a census, was written with
+     * another version of the format, or is truncated.
+     */
+    static bool load(const std::string& path, ComponentCensus& census);
+  private:
+    /**
+     * @brief The number of vertices in each component.
+     */
+    std::vector<uint32_t> num_vertices_;
+
+    /**
+     * @brief The number of edges in each component.
+     */
+    std::vector<uint64_t> num_edges_;
+
+    /**
+     * @brief The total gas of the transactions in each component.
+     */
+    std::vector<uint64_t> total_gas_;
+
+    /**
+     * @brief The total value of the transactions in each component.
+     */
+    std::vector<double> total_value_;
+};
@@ -0,0 +1,62 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "core/csr_graph.h"
+
+/**
+ * @brief The connected components of a graph.
+ */
+struct Components {
+  /**
+   * @brief The value of largest for a graph without vertices.
+   */
+  static constexpr uint32_t NO_COMPONENT = 0xFFFFFFFF;
+
+  /**
+   * @brief The component of every vertex, indexed by vertex ID. Components
+   * are numbered from 0 in order of their lowest vertex ID.
+   */
+  std::vector<uint32_t> labels;
+
+  /**
+   * @brief The number of vertices in each component, indexed by component.
+   */
+  std::vector<uint32_t> sizes;
+
+  /**
+   * @brief The component with the most vertices, or NO_COMPONENT. Ties go to
+   * the component with the lowest vertex ID.
+   */
+  uint32_t largest = NO_COMPONENT;
+};
+
+/**
+ * @brief Find the connected components of the passed compressed graph on
+ * multiple threads using Afforest (Sutton et al.).
+ *
+ * Every vertex starts out as a tree of its own in a union-find forest, where
+ * the parent of a vertex never has a higher ID than the vertex itself. Edges
+ * are linked by hooking the root with the higher ID below the other with an
+ * atomic compare and swap, so threads can link edges concurrently without
+ * locks. Linking every vertex to its first two neighbors already merges most
+ * of the graph into a single tree. The largest tree is then estimated by
+ * sampling, and the remaining edges are only linked for vertices outside of
+ * it, which skips most edges of the giant component of a hub-dominated graph.
+ *
+ * @param g a CSRGraph to find the components of.
+ * @param num_threads an int indicating the number of threads to use.
+ * @return a Components holding the component of every vertex, the size of
+ * every component, and the largest component.
+ */
+Components connected_components(const CSRGraph& g, int num_threads=1);
+
+/**
+ * @brief Get the vertices in the passed component, in order of vertex ID.
+ *
+ * @param components the Components of a graph.
+ * @param component a uint32_t indicating a component.
+ * @return a std::vector<uint32_t> holding the IDs of its vertices.
+ */
+std::vector<uint32_t> component_members(const Components& components,
+                                        uint32_t component);
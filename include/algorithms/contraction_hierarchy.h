@@ -0,0 +1,232 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "algorithms/shortest_path.h"
+#include "algorithms/workspace.h"
+#include "core/csr_graph.h"
+
+/**
+ * @brief The header of a contraction hierarchy file written by
+ * ContractionHierarchy::save. The header is followed by these arrays, each
+ * starting on an 8 byte boundary:
+ *
+ *   uint32_t rank[num_vertices]
+ *   uint64_t up_offsets[num_vertices + 1]  (into the arrays below)
+ *   uint32_t up_targets[num_up_edges]      (vertex IDs)
+ *   uint32_t up_middles[num_up_edges]      (vertex IDs or NO_VERTEX)
+ *   uint64_t up_weights[num_up_edges]
+ */
+struct HierarchyHeader {
+  /**
+   * @brief Identifies the file as a contraction hierarchy. Always
+   * HIERARCHY_MAGIC.
+   */
+  char magic[8];
+
+  /**
+   * @brief The version of the contraction hierarchy file format.
+   */
+  uint32_t version;
+
+  /**
+   * @brief The size of this header in bytes. The first array begins here.
+   */
+  uint32_t header_size;
+
+  /**
+   * @brief The number of vertices of the graph the hierarchy was built for.
+   */
+  uint64_t num_vertices;
+
+  /**
+   * @brief The number of edges of the graph the hierarchy was built for.
+   */
+  uint64_t num_edges;
+
+  /**
+   * @brief A hash of the neighbors and edge weights of the graph the 
+   * hierarchy was built for.
+   */
+  uint64_t fingerprint;
+
+  /**
+   * @brief The number of upward edges, counting shortcuts.
+   */
+  uint64_t num_up_edges;
+
+  /**
+   * @brief Unused space reserved for future versions of the format.
+   */
+  uint64_t reserved[2];
+};
+
+/**
+ * @brief The magic bytes at the start of every contraction hierarchy file.
+ */
+static const char HIERARCHY_MAGIC[8] = {'G', 'T', 'H', 'C', 'H', 'I', 'X', '\0'};
+
+/**
+ * @brief The version of the contraction hierarchy file format written by this
+ * build.
+ */
+static const uint32_t HIERARCHY_VERSION = 1;
+
+/**
+ * @brief A contraction hierarchy over the gas weights of a CSRGraph, which
+ * answers point-to-point shortest path queries by searching only a small part
+ * of the graph.
+ *
+ * The hierarchy is built by removing ("contracting") vertices one at a time, 
+ * least important first. Whenever removing a vertex v would lengthen the 
+ * shortest path between two of its remaining neighbors u and w, a shortcut 
+ * edge u - w with the length of the path u - v - w is added. The order in 
+ * which vertices were removed is their rank. Every shortest path in the graph
+ * is then matched by a path in the graph plus shortcuts that first only climbs
+ * to higher ranks and then only descends, so a query runs Dijkstra's algorithm
+ * upward from both endpoints and joins the two searches at their best common
+ * vertex. Shortcuts record the vertex they skip, so the path can be unpacked 
+ * into original edges.
+ *
+ * Contracting a vertex of high degree would add a shortcut between most pairs
+ * of its neighbors, so such vertices are left uncontracted. They form the 
+ * "core" of the hierarchy, which ranks above every contracted vertex and 
+ * within which queries run plain Dijkstra's algorithm.
+ *
+ * Each vertex only keeps its upward edges, which are the edges it had to its
+ * remaining neighbors when it was contracted, in a compressed adjacency array.
+ * Core vertices keep all of their edges to each other.
+ */
+class ContractionHierarchy {
+  public:
+    /**
+     * @brief Construct an empty hierarchy with no vertices.
+     */
+    ContractionHierarchy();
+
+    /**
+     * @brief Build a contraction hierarchy for the passed graph. Vertices are
+     * contracted in rounds. Each round contracts every vertex whose priority 
+     * is lower than that of all of its neighbors, which is a set of vertices
+     * no two of which are adjacent, so the searches that decide which 
+     * shortcuts each of them needs run in parallel. The priority of a vertex
+     * is the number of shortcuts contracting it would add, minus the number
+     * of edges it would remove, plus the number of its neighbors that were 
+     * already contracted, which spreads contraction evenly over the graph.
+     * Contraction stops once every remaining vertex has too many neighbors
+     * to contract, and the remaining vertices become the core.
+     *
+     * @param g a CSRGraph to build the hierarchy for.
+     * @param num_threads an int indicating the number of threads to use.
+     * @return a ContractionHierarchy for the passed graph.
+     */
+    static ContractionHierarchy build(const CSRGraph& g, int num_threads=1);
+
+    /**
+     * @brief Write this hierarchy to a file at the given path. Existing files
+     * at the given path are overwritten.
+     *
+     * @param path a string indicating the path to write the hierarchy to.
+     * @param g the CSRGraph this hierarchy was built for.
+     * @return true if the file was written successfully.
+     * @return false if the file could not be opened or written.
+     */
+    bool save(const std::string& path, const CSRGraph& g) const;
+
+    /**
+     * @brief Read a hierarchy file written by `save` for the passed graph.
+     *
+     * @param path a string indicating the path to read the hierarchy from.
+     * @param g the CSRGraph the hierarchy must have been built for.
+     * @param hierarchy a ContractionHierarchy to fill with the file contents.
+     * @return true if the file was read and matches the passed graph.
+     * @return false if the file is missing, malformed, or was built for a 
+     * different graph, in which case hierarchy is left unchanged.
+     */
+    static bool load(const std::string& path, const CSRGraph& g,
+                     ContractionHierarchy& hierarchy);
+
+    /**
+     * @brief Get the number of vertices in the hierarchy.
+     */
+    uint32_t numVertices() const { return rank_.size(); }
+
+    /**
+     * @brief Get the number of upward edges, counting shortcuts.
+     */
+    uint64_t numUpEdges() const { return up_targets_.size(); }
+
+    /**
+     * @brief Get the number of upward edges that are shortcuts.
+     */
+    uint64_t numShortcuts() const;
+
+    /**
+     * @brief Get the position of the passed vertex in the contraction order.
+     *
+     * @param v a uint32_t indicating the ID of a vertex.
+     */
+    uint32_t getRank(uint32_t v) const { return rank_[v]; }
+
+    /**
+     * @brief Find the shortest path between two vertices by searching upward
+     * from both of them. A direction stops once its closest unsettled vertex
+     * is at least as far as the best path found, and a vertex is not expanded
+     * if a higher ranked vertex already reached it on a shorter path, since
+     * no shortest path continues upward through it ("stall-on-demand").
+     *
+     * @param source a uint32_t indicating the ID of the first vertex.
+     * @param target a uint32_t indicating the ID of the last vertex.
+     * @param forward a TraversalWorkspace sized for the graph to search 
+     * upward from the source with.
+     * @param backward a TraversalWorkspace sized for the graph to search 
+     * upward from the target with.
+     * @return a ShortestPath holding the distance and the vertices of the 
+     * path in the original graph, with every shortcut unpacked.
+     */
+    ShortestPath query(uint32_t source, uint32_t target, 
+                       TraversalWorkspace& forward,
+                       TraversalWorkspace& backward) const;
+  private:
+    /**
+     * @brief Settle the closest unsettled vertex of one direction of a query
+     * and relax its upward edges, recording the best path through it.
+     */
+    void advance(TraversalWorkspace& self, const TraversalWorkspace& other,
+                 uint64_t& best, uint32_t& meet) const;
+
+    /**
+     * @brief Append the original vertices of the upward edge between a and b
+     * to the passed path, from a up to but excluding b.
+     */
+    void unpack(uint32_t a, uint32_t b, std::vector<uint32_t>& path) const;
+
+    /**
+     * @brief The position of every vertex in the contraction order.
+     */
+    std::vector<uint32_t> rank_;
+
+    /**
+     * @brief numVertices() + 1 indices into the upward edge arrays. The 
+     * upward edges of vertex v are stored in [up_offsets_[v], 
+     * up_offsets_[v + 1]).
+     */
+    std::vector<uint64_t> up_offsets_;
+
+    /**
+     * @brief The higher ranked endpoint of every upward edge.
+     */
+    std::vector<uint32_t> up_targets_;
+
+    /**
+     * @brief The vertex each upward edge skips if it is a shortcut, or 
+     * TraversalWorkspace::NO_VERTEX if it is an original edge.
+     */
+    std::vector<uint32_t> up_middles_;
+
+    /**
+     * @brief The length of every upward edge.
+     */
+    std::vector<uint64_t> up_weights_;
+};
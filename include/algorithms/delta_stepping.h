@@ -0,0 +1,46 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "utils/thread_pool.h"
+#include "core/csr_graph.h"
+
+/**
+ * @brief Pick a bucket width for delta_stepping on the passed graph: the mean
+ * edge weight, rounded up. Narrower buckets do less redundant work per bucket
+ * but leave less parallel work in each one.
+ *
+ * @param g a CSRGraph to pick a bucket width for.
+ * @return a uint64_t of at least 1 indicating the bucket width.
+ */
+uint64_t default_delta(const CSRGraph& g);
+
+/**
+ * @brief Find the length of the shortest path from a single source vertex to
+ * every vertex of a CSRGraph on multiple threads using delta-stepping.
+ *
+ * Vertices are grouped into buckets of tentative distance, where bucket i
+ * holds vertices at distances [i * delta, (i + 1) * delta). Buckets are 
+ * processed in order. While processing a bucket, every vertex in it relaxes
+ * its light edges (weight at most delta) in parallel, which may refill the 
+ * same bucket, until it stays empty. The heavy edges of every vertex removed
+ * from the bucket are then relaxed once in parallel, since they can only
+ * reach later buckets. Distances are lowered with atomic compare and swap, 
+ * and each thread collects the vertices it moved into its own buffer, so the
+ * buffers are only merged into the buckets between phases.
+ *
+ * A delta of 1 behaves like Dijkstra's algorithm, processing one distance at
+ * a time, and a delta larger than every distance behaves like Bellman-Ford.
+ * The distances found are the same as those of dijkstra for any delta.
+ *
+ * @param g a CSRGraph indicating the graph to search.
+ * @param start a uint32_t indicating the ID of the source vertex.
+ * @param delta a uint64_t indicating the width of each bucket. 0 uses
+ * default_delta.
+ * @param pool a ThreadPool to relax edges with.
+ * @return a std::vector<uint64_t> holding the distance to every vertex indexed
+ * by vertex ID, or TraversalWorkspace::UNREACHED for vertices that cannot be 
+ * reached from the source.
+ */
+std::vector<uint64_t> delta_stepping(const CSRGraph& g, uint32_t start, 
+                                     uint64_t delta, ThreadPool& pool);
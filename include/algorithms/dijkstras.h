@@ -1,7 +1,10 @@
 #pragma once
+#include "algorithms/workspace.h"
+#include "core/csr_graph.h"
 #include "core/vertex.h"
 #include "core/graph.h"
 #include <string>
+#include <vector>
 
 /**
  * @brief Run Dijkstra's algorithm to find the shortest path from a single 
@@ -11,9 +14,165 @@
  * the vertex so that the shortest path to some arbitary vertex may be recovered 
  * by backtracking to the starting vertex.
  * 
+ * The results are stored in the vertices themselves, so this function must not
+ * be run on the same graph from several threads at once. Searches that need to
+ * share one graph between threads use the CSRGraph overload below.
+ * 
  * @param g a Graph* indicating the graph with which to find the shortest path 
  * from the given starting vertex to all other vertices in the graph.
  * @param start a Vertex* indicating the start vertex from which we are find all 
  * of the shortest paths to all other nodes in the given graph.
  */
 void dijkstra(Graph* g, Vertex* start);
+
+/**
+ * @brief The priority queues that Dijkstra's algorithm on a CSRGraph can use
+ * to pick the next vertex to settle.
+ */
+enum class QueueType {
+  /**
+   * @brief A std::priority_queue that receives a new entry every time the 
+   * distance to a vertex improves. Stale entries are skipped when popped, so 
+   * the queue can grow to hold one entry per edge.
+   */
+  LAZY_BINARY_HEAP,
+
+  /**
+   * @brief An IndexedHeap, a 4-ary heap with decrease-key that holds each
+   * vertex at most once.
+   */
+  INDEXED_HEAP,
+
+  /**
+   * @brief A RadixHeap, a monotone queue for integer distances.
+   */
+  RADIX_HEAP,
+
+  /**
+   * @brief A BucketQueue (Dial's algorithm). Only used when the largest edge 
+   * weight is at most BucketQueue::MAX_WEIGHT; a RADIX_HEAP is used instead 
+   * on graphs with heavier edges.
+   */
+  BUCKET_QUEUE,
+
+  /**
+   * @brief A BUCKET_QUEUE if the largest edge weight of the graph is at most
+   * BucketQueue::MAX_WEIGHT, and a RADIX_HEAP otherwise. Edge weights are 
+   * integral gas amounts, so a monotone integer queue always applies.
+   */
+  AUTO
+};
+
+/**
+ * @brief Get the queue type with the passed name as given on the command
+ * line: "lazy" for LAZY_BINARY_HEAP, "heap" for INDEXED_HEAP, "radix" for 
+ * RADIX_HEAP, "dial" for BUCKET_QUEUE, or "auto" for AUTO.
+ *
+ * @param name a std::string indicating the name of a queue type.
+ * @param queue a QueueType to set to the named queue type.
+ * @return true if the name is the name of a queue type.
+ * @return false otherwise, in which case queue is left unchanged.
+ */
+bool parse_queue_type(const std::string& name, QueueType& queue);
+
+/**
+ * @brief Run Dijkstra's algorithm to find the shortest path from a single 
+ * source vertex of a CSRGraph. The graph is only read, and all results are 
+ * written to the passed workspace: the shortest distance to every vertex, a 
+ * predecessor of every vertex on some shortest path, the number of shortest 
+ * paths to every vertex, every predecessor of every vertex on any shortest 
+ * path, and the order in which vertices were settled. Together these are 
+ * everything Brandes' algorithm needs to accumulate dependencies.
+ * 
+ * Because the graph is never modified, multiple threads may search the same
+ * CSRGraph at once as long as each uses its own workspace.
+ * 
+ * @param g a CSRGraph indicating the graph with which to find the shortest 
+ * path from the given starting vertex to all other vertices in the graph.
+ * @param start a uint32_t indicating the ID of the vertex from which we are 
+ * finding all of the shortest paths to all other nodes in the given graph.
+ * @param workspace a TraversalWorkspace sized for the graph that is reset and
+ * then filled with the results of the search.
+ * @param queue a QueueType indicating the priority queue to search with.
+ */
+void dijkstra(const CSRGraph& g, uint32_t start, TraversalWorkspace& workspace,
+              QueueType queue=QueueType::AUTO);
+
+/**
+ * @brief Conditions under which a search on a CSRGraph stops before settling
+ * every vertex reachable from its source. The search stops as soon as any one
+ * of them is met, so the default value of each never stops it.
+ */
+struct SearchLimits {
+  /**
+   * @brief The largest distance a settled vertex may have. Vertices further
+   * from the source are never settled.
+   */
+  uint64_t max_distance = TraversalWorkspace::UNREACHED;
+
+  /**
+   * @brief The largest number of vertices to settle, counting the source. 
+   * The settled vertices are then the max_settled vertices closest to the 
+   * source.
+   */
+  uint32_t max_settled = 0xFFFFFFFF;
+
+  /**
+   * @brief Vertices whose distances are needed. The search stops once all of
+   * them are settled. Ignored if empty.
+   */
+  std::vector<uint32_t> targets;
+};
+
+/**
+ * @brief Run Dijkstra's algorithm from a single source vertex of a CSRGraph
+ * until one of the passed limits is reached. The results are written to the
+ * passed workspace as in the unbounded search, but only the vertices in
+ * `getSettledOrder()` are guaranteed to have their final distance, parent, 
+ * and path counts. Vertices that were reached but not settled hold the 
+ * shortest distance found before the search stopped.
+ *
+ * Starting a search on a workspace takes constant time, so the cost of a 
+ * bounded search only depends on the part of the graph it explores.
+ *
+ * @param g a CSRGraph to search.
+ * @param start a uint32_t indicating the ID of the vertex to search from.
+ * @param workspace a TraversalWorkspace sized for the graph that is reset and
+ * then filled with the results of the search.
+ * @param limits a SearchLimits indicating when to stop the search.
+ * @param queue a QueueType indicating the priority queue to search with.
+ */
+void bounded_dijkstra(const CSRGraph& g, uint32_t start, 
+                      TraversalWorkspace& workspace, const SearchLimits& limits,
+                      QueueType queue=QueueType::AUTO);
+
+/**
+ * @brief Run Dijkstra's algorithm from several source vertices of a CSRGraph
+ * at once, finding the distance from every vertex to its closest source. All
+ * of the sources are queued at distance 0 and the graph is searched once,
+ * which gives the same distances as searching from each source separately and
+ * keeping the smallest distance to each vertex.
+ *
+ * The results are written to the passed workspace as in the single source 
+ * search, and following parents from any settled vertex ends at one of its
+ * closest sources.
+ *
+ * @param g a CSRGraph to search.
+ * @param sources a std::vector<uint32_t> of the IDs of the vertices to search
+ * from.
+ * @param workspace a TraversalWorkspace sized for the graph that is reset and
+ * then filled with the results of the search.
+ * @param nearest_source a std::vector<uint32_t> that is resized to hold the ID
+ * of the closest source of every vertex, or TraversalWorkspace::NO_VERTEX for
+ * vertices that were not settled. Vertices with several closest sources are 
+ * given one of them.
+ * @param limits a SearchLimits indicating when to stop the search, where 
+ * distances are measured from the closest source.
+ * @param queue a QueueType indicating the priority queue to search with.
+ */
+void multi_source_dijkstra(const CSRGraph& g, 
+                           const std::vector<uint32_t>& sources,
+                           TraversalWorkspace& workspace,
+                           std::vector<uint32_t>& nearest_source,
+                           const SearchLimits& limits=SearchLimits(),
+                           QueueType queue=QueueType::AUTO);
@@ -0,0 +1,126 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "core/csr_graph.h"
+
+/**
+ * @brief A 2-hop labeling of a CSRGraph that answers exact hop distance 
+ * queries, the number of transactions on the shortest chain between two
+ * addresses, without searching the graph.
+ *
+ * Every vertex v is given a label: a list of (hub, d) entries, meaning v is d
+ * hops from the hub. Labels are built so that every pair of connected vertices
+ * shares a hub on one of their shortest paths, so the hop distance between u
+ * and v is the smallest d(u, h) + d(h, v) over the hubs h in both of their 
+ * labels. Entries are sorted by hub, so a query is a single merge of two 
+ * sorted lists.
+ *
+ * Labels are built by pruned landmark labeling: a breadth first search is run
+ * from every vertex in order of decreasing degree, and adds the vertex as a
+ * hub to the labels of the vertices it reaches. The search does not label or
+ * expand a vertex whose distance is already answered by the labels built so 
+ * far, so searches from the well connected addresses that come first cover 
+ * most shortest paths and later searches stop almost immediately.
+ */
+class HopLabeling {
+  public:
+    /**
+     * @brief The hop distance between two vertices that are not connected.
+     */
+    static constexpr uint32_t UNREACHED = 0xFFFFFFFF;
+
+    /**
+     * @brief A single entry of the label of a vertex.
+     */
+    struct LabelEntry {
+      /**
+       * @brief The position of the hub in the order searches were run in. 
+       * Entries of a label are sorted by this field.
+       */
+      uint32_t hub;
+
+      /**
+       * @brief The number of hops between the vertex and the hub.
+       */
+      uint32_t distance;
+    };
+
+    /**
+     * @brief Construct an empty labeling with no vertices.
+     */
+    HopLabeling();
+
+    /**
+     * @brief Build a hop labeling for the passed graph. With more than one
+     * thread, searches run in batches of one search per thread. The searches
+     * of a batch run in parallel and only prune with the labels of earlier 
+     * batches, so their labels may hold a few entries a sequential build 
+     * would have pruned, but queries return the same distances.
+     *
+     * @param g a CSRGraph to build the labeling for.
+     * @param num_threads an int indicating the number of threads to use.
+     * @return a HopLabeling for the passed graph.
+     */
+    static HopLabeling build(const CSRGraph& g, int num_threads=1);
+
+    /**
+     * @brief Get the number of hops on the shortest chain of transactions 
+     * between two vertices.
+     *
+     * @param u a uint32_t indicating the ID of the first vertex.
+     * @param v a uint32_t indicating the ID of the second vertex.
+     * @return a uint32_t indicating the hop distance, or UNREACHED.
+     */
+    uint32_t query(uint32_t u, uint32_t v) const;
+
+    /**
+     * @brief Get the number of vertices in the labeling.
+     */
+    uint32_t numVertices() const { return order_.size(); }
+
+    /**
+     * @brief Get the total number of entries in the labels of every vertex.
+     */
+    uint64_t numEntries() const { return entries_.size(); }
+
+    /**
+     * @brief Get the vertex ID of the hub at the passed position of the order
+     * searches were run in, as stored in LabelEntry::hub.
+     *
+     * @param hub a uint32_t in [0, numVertices()).
+     */
+    uint32_t getHub(uint32_t hub) const { return order_[hub]; }
+
+    /**
+     * @brief Get the number of entries in the label of the passed vertex.
+     *
+     * @param v a uint32_t indicating the ID of a vertex.
+     */
+    uint32_t labelSize(uint32_t v) const { 
+      return offsets_[v + 1] - offsets_[v]; 
+    }
+
+    /**
+     * @brief Get the number of bytes of memory the labels take up.
+     *
+     * @return a uint64_t indicating the size of the labeling in bytes.
+     */
+    uint64_t memoryUsage() const;
+  private:
+    /**
+     * @brief The vertex ID of every hub, in the order searches were run in.
+     */
+    std::vector<uint32_t> order_;
+
+    /**
+     * @brief numVertices() + 1 indices into entries_. The label of vertex v
+     * is stored in [offsets_[v], offsets_[v + 1]).
+     */
+    std::vector<uint64_t> offsets_;
+
+    /**
+     * @brief The labels of every vertex, stored back to back.
+     */
+    std::vector<LabelEntry> entries_;
+};
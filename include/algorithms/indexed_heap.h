@@ -0,0 +1,175 @@
+#pragma once
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief A min-priority queue of vertex IDs keyed by distance that holds each
+ * vertex at most once. Lowering the key of a vertex already in the queue moves
+ * it in place instead of pushing a duplicate, so the queue never holds more
+ * than one entry per vertex.
+ *
+ * The queue is a 4-ary heap of (distance, ID) pairs stored inline in a single
+ * array, so comparing two entries never follows a pointer. A second array
+ * indexed by vertex ID records where each vertex currently sits in the heap.
+ * Compared to a binary heap, a 4-ary heap is half as deep, and the four
+ * children of a node share a cache line.
+ */
+class IndexedHeap {
+  public:
+    /**
+     * @brief The number of children of each node in the heap.
+     */
+    static constexpr uint32_t ARITY = 4;
+
+    /**
+     * @brief The position of a vertex that is not in the heap.
+     */
+    static constexpr uint32_t NOT_IN_HEAP = 0xFFFFFFFF;
+
+    /**
+     * @brief Construct an empty heap that can hold the vertices [0, size).
+     *
+     * @param size a uint32_t indicating the number of vertices in the graph.
+     */
+    explicit IndexedHeap(uint32_t size) : heap_(), position_(size, NOT_IN_HEAP) {
+      heap_.reserve(size);
+    }
+
+    /**
+     * @brief Check whether the heap holds no vertices.
+     */
+    bool empty() const { return heap_.empty(); }
+
+    /**
+     * @brief Get the number of vertices in the heap.
+     */
+    uint32_t size() const { return heap_.size(); }
+
+    /**
+     * @brief Check whether the passed vertex is in the heap.
+     *
+     * @param v a uint32_t indicating the ID of a vertex.
+     */
+    bool contains(uint32_t v) const { return position_[v] != NOT_IN_HEAP; }
+
+    /**
+     * @brief Get the vertex with the smallest distance in the heap. The heap
+     * must not be empty.
+     *
+     * @return a std::pair of the smallest distance and the ID of its vertex.
+     */
+    const std::pair<uint64_t, uint32_t>& top() const { return heap_[0]; }
+
+    /**
+     * @brief Insert the passed vertex with the passed distance, or lower its
+     * distance if it is already in the heap. Distances are never raised.
+     *
+     * @param v a uint32_t indicating the ID of a vertex.
+     * @param distance a uint64_t indicating the distance of the vertex.
+     */
+    void pushOrDecrease(uint32_t v, uint64_t distance) {
+      uint32_t index = position_[v];
+
+      if (index == NOT_IN_HEAP) {
+        index = heap_.size();
+        heap_.push_back({distance, v});
+      } else if (distance < heap_[index].first) {
+        heap_[index].first = distance;
+      } else {
+        return;
+      }
+
+      siftUp(index);
+    }
+
+    /**
+     * @brief Remove the vertex with the smallest distance from the heap. The
+     * heap must not be empty.
+     */
+    void pop() {
+      position_[heap_[0].second] = NOT_IN_HEAP;
+
+      std::pair<uint64_t, uint32_t> last = heap_.back();
+      heap_.pop_back();
+
+      if (!heap_.empty()) {
+        heap_[0] = last;
+        siftDown(0);
+      }
+    }
+
+    /**
+     * @brief Remove every vertex from the heap. Only the vertices still in the
+     * heap are visited, so clearing a heap that was run until empty is free.
+     */
+    void clear() {
+      for (const std::pair<uint64_t, uint32_t>& entry : heap_) {
+        position_[entry.second] = NOT_IN_HEAP;
+      }
+
+      heap_.clear();
+    }
+  private:
+    /**
+     * @brief Move the entry at the passed index up until its parent is no
+     * larger than it.
+     */
+    void siftUp(uint32_t index) {
+      std::pair<uint64_t, uint32_t> entry = heap_[index];
+
+      while (index > 0) {
+        uint32_t parent = (index - 1) / ARITY;
+        if (heap_[parent] <= entry) break;
+
+        heap_[index] = heap_[parent];
+        position_[heap_[index].second] = index;
+        index = parent;
+      }
+
+      heap_[index] = entry;
+      position_[entry.second] = index;
+    }
+
+    /**
+     * @brief Move the entry at the passed index down until none of its
+     * children are smaller than it.
+     */
+    void siftDown(uint32_t index) {
+      std::pair<uint64_t, uint32_t> entry = heap_[index];
+      uint32_t size = heap_.size();
+
+      while (true) {
+        uint32_t first_child = index * ARITY + 1;
+        if (first_child >= size) break;
+
+        uint32_t last_child = first_child + ARITY < size
+          ? first_child + ARITY : size;
+
+        uint32_t smallest = first_child;
+        for (uint32_t child = first_child + 1; child < last_child; ++child) {
+          if (heap_[child] < heap_[smallest]) smallest = child;
+        }
+
+        if (entry <= heap_[smallest]) break;
+
+        heap_[index] = heap_[smallest];
+        position_[heap_[index].second] = index;
+        index = smallest;
+      }
+
+      heap_[index] = entry;
+      position_[entry.second] = index;
+    }
+
+    /**
+     * @brief The (distance, ID) entries of the heap. The children of the
+     * entry at index i are at indices [ARITY * i + 1, ARITY * i + ARITY].
+     */
+    std::vector<std::pair<uint64_t, uint32_t>> heap_;
+
+    /**
+     * @brief The index in heap_ of each vertex, or NOT_IN_HEAP.
+     */
+    std::vector<uint32_t> position_;
+};
@@ -0,0 +1,189 @@
+#pragma once
+#include <cstdint>
+#include <string>
+#include <vector>
+
+#include "algorithms/shortest_path.h"
+#include "algorithms/workspace.h"
+#include "core/csr_graph.h"
+
+/**
+ * @brief The header of a landmark file written by LandmarkIndex::save. The
+ * header is followed by these arrays, each starting on an 8 byte boundary:
+ *
+ *   uint8_t  landmark_addresses[num_landmarks * Address::SIZE]
+ *   uint32_t landmarks[num_landmarks]           (vertex IDs)
+ *   uint64_t distances[num_vertices * num_landmarks]
+ *
+ * The number of vertices and edges and the address of every landmark are
+ * checked against the graph when a file is loaded, so tables computed for a
+ * different graph are rejected.
+ */
+struct LandmarkHeader {
+  /**
+   * @brief Identifies the file as a landmark file. Always LANDMARK_MAGIC.
+   */
+  char magic[8];
+
+  /**
+   * @brief The version of the landmark file format.
+   */
+  uint32_t version;
+
+  /**
+   * @brief The size of this header in bytes. The first array begins here.
+   */
+  uint32_t header_size;
+
+  /**
+   * @brief The number of vertices of the graph the tables were computed for.
+   */
+  uint64_t num_vertices;
+
+  /**
+   * @brief The number of edges of the graph the tables were computed for.
+   */
+  uint64_t num_edges;
+
+  /**
+   * @brief The number of landmarks.
+   */
+  uint64_t num_landmarks;
+
+  /**
+   * @brief Unused space reserved for future versions of the format.
+   */
+  uint64_t reserved[2];
+};
+
+/**
+ * @brief The magic bytes at the start of every landmark file.
+ */
+static const char LANDMARK_MAGIC[8] = {'G', 'T', 'H', 'L', 'M', 'R', 'K', '\0'};
+
+/**
+ * @brief The version of the landmark file format written by this build.
+ */
+static const uint32_t LANDMARK_VERSION = 1;
+
+/**
+ * @brief Precomputed shortest path distances from a few landmark vertices to
+ * every vertex, used to bound the distance between any two vertices from 
+ * below. For a landmark L and vertices v and t, the triangle inequality gives
+ * d(v, t) >= |d(L, t) - d(L, v)|, so the largest such difference over all
+ * landmarks is a lower bound that A* search can use to aim at t.
+ *
+ * The distances of each vertex to every landmark are stored next to each 
+ * other, so computing a bound for a vertex reads one short contiguous row.
+ */
+class LandmarkIndex {
+  public:
+    /**
+     * @brief Construct an empty index with no landmarks, whose bounds are 
+     * always 0.
+     */
+    LandmarkIndex();
+
+    /**
+     * @brief Pick the num_landmarks vertices of highest degree as landmarks
+     * and compute the distance from each to every vertex. Highly connected
+     * addresses sit on many shortest paths, which tends to make their bounds
+     * tight. The searches from each landmark run in parallel.
+     *
+     * @param g a CSRGraph to build the index for.
+     * @param num_landmarks an int indicating the number of landmarks.
+     * @param num_threads an int indicating the number of threads to use.
+     * @return a LandmarkIndex for the passed graph.
+     */
+    static LandmarkIndex build(const CSRGraph& g, int num_landmarks, 
+                               int num_threads=1);
+
+    /**
+     * @brief Write this index to a landmark file at the given path. Existing
+     * files at the given path are overwritten.
+     *
+     * @param path a string indicating the path to write the index to.
+     * @param g the CSRGraph this index was built for.
+     * @return true if the file was written successfully.
+     * @return false if the file could not be opened or written.
+     */
+    bool save(const std::string& path, const CSRGraph& g) const;
+
+    /**
+     * @brief Read a landmark file written by `save` for the passed graph.
+     *
+     * @param path a string indicating the path to read the index from.
+     * @param g the CSRGraph the index must have been built for.
+     * @param index a LandmarkIndex to fill with the contents of the file.
+     * @return true if the file was read and matches the passed graph.
+     * @return false if the file is missing, malformed, or was built for a 
+     * different graph, in which case index is left unchanged.
+     */
+    static bool load(const std::string& path, const CSRGraph& g,
+                     LandmarkIndex& index);
+
+    /**
+     * @brief Get the number of landmarks.
+     */
+    uint32_t numLandmarks() const { return landmarks_.size(); }
+
+    /**
+     * @brief Get the vertex ID of a landmark.
+     *
+     * @param i a uint32_t in [0, numLandmarks()).
+     */
+    uint32_t getLandmark(uint32_t i) const { return landmarks_[i]; }
+
+    /**
+     * @brief Get the distance from a landmark to a vertex.
+     *
+     * @param i a uint32_t in [0, numLandmarks()).
+     * @param v a uint32_t indicating the ID of a vertex.
+     * @return a uint64_t indicating the distance, or 
+     * TraversalWorkspace::UNREACHED if the vertex cannot reach the landmark.
+     */
+    uint64_t getDistance(uint32_t i, uint32_t v) const { 
+      return distances_[static_cast<uint64_t>(v) * landmarks_.size() + i];
+    }
+
+    /**
+     * @brief Get a lower bound on the distance between two vertices.
+     *
+     * @param v a uint32_t indicating the ID of a vertex.
+     * @param t a uint32_t indicating the ID of another vertex.
+     * @return a uint64_t no larger than the distance between v and t, or
+     * TraversalWorkspace::UNREACHED if a landmark proves that no path exists.
+     */
+    uint64_t lowerBound(uint32_t v, uint32_t t) const;
+  private:
+    /**
+     * @brief The vertex ID of each landmark.
+     */
+    std::vector<uint32_t> landmarks_;
+
+    /**
+     * @brief The distance from every landmark to every vertex, stored as one
+     * row of numLandmarks() distances per vertex.
+     */
+    std::vector<uint64_t> distances_;
+};
+
+/**
+ * @brief Find the shortest path between two vertices of a CSRGraph using A*
+ * search guided by landmark lower bounds (ALT). The search settles vertices 
+ * in order of their distance from the source plus the bound on their 
+ * distance to the target, so vertices leading away from the target are 
+ * settled late or not at all. The bounds never overestimate and are 
+ * consistent, so the search stops as soon as the target is settled. An index
+ * without landmarks falls back to Dijkstra's algorithm.
+ *
+ * @param g a CSRGraph indicating the graph to search.
+ * @param index a LandmarkIndex built for the graph.
+ * @param source a uint32_t indicating the ID of the first vertex of the path.
+ * @param target a uint32_t indicating the ID of the last vertex of the path.
+ * @param workspace a TraversalWorkspace sized for the graph to search with.
+ * @return a ShortestPath holding the distance and vertices of the path.
+ */
+ShortestPath alt_shortest_path(const CSRGraph& g, const LandmarkIndex& index,
+                               uint32_t source, uint32_t target,
+                               TraversalWorkspace& workspace);
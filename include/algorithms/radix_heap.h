@@ -0,0 +1,134 @@
+#pragma once
+#include <cstdint>
+#include <utility>
+#include <vector>
+
+/**
+ * @brief A monotone min-priority queue of vertex IDs keyed by integer
+ * distance. A radix heap relies on the fact that Dijkstra's algorithm never
+ * pushes a distance smaller than the last distance popped, which holds because
+ * edge weights are non-negative integers.
+ *
+ * Entries are kept in 65 buckets. Bucket 0 holds entries whose distance equals
+ * the last distance popped, and bucket i > 0 holds entries whose distance
+ * first differs from it in bit i - 1, counting from the least significant bit.
+ * When bucket 0 runs out, the smallest entry of the first non-empty bucket
+ * becomes the new last distance and that bucket is redistributed into lower
+ * buckets. Each entry can only move down 64 times, so a search costs
+ * O(E + V log C) where C is the largest edge weight, with no comparisons
+ * between entries on push.
+ *
+ * Like the lazy binary heap, improving the distance of a vertex pushes a new
+ * entry, so callers must skip vertices that were already settled.
+ */
+class RadixHeap {
+  public:
+    /**
+     * @brief The number of buckets, one more than the number of bits in a
+     * distance.
+     */
+    static constexpr int NUM_BUCKETS = 65;
+
+    /**
+     * @brief Construct an empty heap whose last popped distance is 0.
+     */
+    RadixHeap() : buckets_(NUM_BUCKETS), last_(0), size_(0) { }
+
+    /**
+     * @brief Check whether the heap holds no entries.
+     */
+    bool empty() const { return size_ == 0; }
+
+    /**
+     * @brief Get the entry with the smallest distance in the heap, which
+     * becomes the new lower bound on distances that may be pushed. The heap
+     * must not be empty.
+     *
+     * @return a std::pair of the smallest distance and the ID of its vertex.
+     */
+    const std::pair<uint64_t, uint32_t>& top() {
+      if (buckets_[0].empty()) refill();
+      return buckets_[0].back();
+    }
+
+    /**
+     * @brief Add an entry for the passed vertex with the passed distance,
+     * which must be no smaller than the last distance returned by top.
+     *
+     * @param v a uint32_t indicating the ID of a vertex.
+     * @param distance a uint64_t indicating the distance of the vertex.
+     */
+    void pushOrDecrease(uint32_t v, uint64_t distance) {
+      buckets_[bucket(distance)].push_back({distance, v});
+      ++size_;
+    }
+
+    /**
+     * @brief Remove the entry with the smallest distance from the heap. The
+     * heap must not be empty.
+     */
+    void pop() {
+      if (buckets_[0].empty()) refill();
+      buckets_[0].pop_back();
+      --size_;
+    }
+
+    /**
+     * @brief Remove every entry and reset the last popped distance to 0 so
+     * that a new search can begin.
+     */
+    void clear() {
+      if (size_ != 0) {
+        for (std::vector<std::pair<uint64_t, uint32_t>>& b : buckets_) b.clear();
+      }
+
+      last_ = 0;
+      size_ = 0;
+    }
+  private:
+    /**
+     * @brief Get the bucket an entry with the passed distance belongs in.
+     */
+    int bucket(uint64_t distance) const {
+      return distance == last_ ? 0 : 64 - __builtin_clzll(distance ^ last_);
+    }
+
+    /**
+     * @brief Move the smallest distance in the first non-empty bucket into
+     * last_ and redistribute that bucket. Every entry of the bucket lands in a
+     * lower bucket, and at least one lands in bucket 0.
+     */
+    void refill() {
+      int i = 1;
+      while (buckets_[i].empty()) ++i;
+
+      uint64_t smallest = buckets_[i][0].first;
+      for (const std::pair<uint64_t, uint32_t>& entry : buckets_[i]) {
+        if (entry.first < smallest) smallest = entry.first;
+      }
+
+      last_ = smallest;
+      for (const std::pair<uint64_t, uint32_t>& entry : buckets_[i]) {
+        buckets_[bucket(entry.first)].push_back(entry);
+      }
+
+      buckets_[i].clear();
+    }
+
+    /**
+     * @brief The entries of the heap grouped by their highest bit that
+     * differs from last_.
+     */
+    std::vector<std::vector<std::pair<uint64_t, uint32_t>>> buckets_;
+
+    /**
+     * @brief The last distance returned by top, a lower bound on every
+     * distance in the heap.
+     */
+    uint64_t last_;
+
+    /**
+     * @brief The number of entries in the heap.
+     */
+    uint64_t size_;
+};
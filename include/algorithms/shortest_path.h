@@ -0,0 +1,67 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "algorithms/workspace.h"
+#include "core/csr_graph.h"
+
+/**
+ * @brief The result of a point-to-point shortest path query.
+ */
+struct ShortestPath {
+  /**
+   * @brief The length of the shortest path, or TraversalWorkspace::UNREACHED
+   * if there is no path.
+   */
+  uint64_t distance;
+
+  /**
+   * @brief The IDs of the vertices on the shortest path from the source to
+   * the target, both included. Empty if there is no path.
+   */
+  std::vector<uint32_t> path;
+
+  /**
+   * @brief The number of vertices settled to answer the query, summed over
+   * both directions of the search.
+   */
+  uint64_t settled;
+};
+
+/**
+ * @brief Find the shortest path between two vertices of a CSRGraph using 
+ * bidirectional Dijkstra. One search grows from the source and another from 
+ * the target, and each step advances the search whose closest unsettled 
+ * vertex is nearer. Whenever an edge joins the two searches, the length of 
+ * the path through that edge is recorded. The search stops as soon as the 
+ * closest unsettled distances of the two searches add up to at least the 
+ * shortest recorded path, since no path found later could be shorter. Both
+ * searches then cover roughly half the shortest path distance each, which 
+ * settles far fewer vertices than a single search covering all of it.
+ *
+ * Every edge is undirected, so both searches follow the same adjacency.
+ *
+ * @param g a CSRGraph indicating the graph to search.
+ * @param source a uint32_t indicating the ID of the first vertex of the path.
+ * @param target a uint32_t indicating the ID of the last vertex of the path.
+ * @param forward a TraversalWorkspace sized for the graph to grow the search
+ * from the source in.
+ * @param backward a TraversalWorkspace sized for the graph to grow the search
+ * from the target in.
+ * @return a ShortestPath holding the distance and vertices of the path.
+ */
+ShortestPath shortest_path(const CSRGraph& g, uint32_t source, uint32_t target,
+                           TraversalWorkspace& forward, 
+                           TraversalWorkspace& backward);
+
+/**
+ * @brief Find the shortest path between two vertices of a CSRGraph using 
+ * bidirectional Dijkstra, allocating the workspaces for a single query. Refer
+ * to the overload above.
+ *
+ * @param g a CSRGraph indicating the graph to search.
+ * @param source a uint32_t indicating the ID of the first vertex of the path.
+ * @param target a uint32_t indicating the ID of the last vertex of the path.
+ * @return a ShortestPath holding the distance and vertices of the path.
+ */
+ShortestPath shortest_path(const CSRGraph& g, uint32_t source, uint32_t target);
@@ -0,0 +1,137 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "algorithms/bitmap.h"
+#include "core/csr_graph.h"
+
+/**
+ * @brief The subgraph induced by a set of vertices of a larger graph, kept as
+ * a view over the vertex IDs of the larger (parent) graph rather than as a
+ * copy of its vertices and edges. An edge of the parent belongs to the view
+ * when both of its endpoints do.
+ *
+ * Membership is a bitmap over the parent's vertex IDs. The vertices of the
+ * view are given their own dense local IDs in order of parent ID. A local ID
+ * is the number of members with a lower parent ID, which is found from a
+ * running count of members kept for every 64 vertices plus a population count
+ * within one word of the bitmap. The whole view costs 1.5 bits per parent
+ * vertex plus 4 bytes per member.
+ *
+ * Algorithms can run on a view together with its parent, skipping the edges
+ * that leave the view, and `materialize` builds a standalone CSRGraph of the
+ * subgraph in parallel when one is needed.
+ */
+class SubgraphView {
+  public:
+    /**
+     * @brief The local ID returned for vertices that are not in the view.
+     */
+    static constexpr uint32_t NO_VERTEX = 0xFFFFFFFF;
+
+    /**
+     * @brief Construct an empty view over a parent without vertices.
+     */
+    SubgraphView();
+
+    /**
+     * @brief Construct a view of the subgraph induced by the passed vertices.
+     *
+     * @param num_parent_vertices a uint32_t indicating the number of vertices
+     * of the parent graph.
+     * @param vertices a std::vector<uint32_t> holding the parent IDs of the
+     * vertices in the view, in any order. Duplicates are ignored.
+     */
+    SubgraphView(uint32_t num_parent_vertices,
+                 const std::vector<uint32_t>& vertices);
+
+    /**
+     * @brief Get the number of vertices in the view.
+     *
+     * @return a uint32_t indicating the number of vertices.
+     */
+    uint32_t numVertices() const { return members_.size(); }
+
+    /**
+     * @brief Get the number of vertices of the parent graph.
+     *
+     * @return a uint32_t indicating the number of parent vertices.
+     */
+    uint32_t numParentVertices() const { return membership_.size(); }
+
+    /**
+     * @brief Check whether the passed vertex of the parent is in the view.
+     *
+     * @param v a uint32_t indicating the parent ID of a vertex.
+     * @return true if the vertex IS in the view.
+     * @return false if the vertex is NOT in the view.
+     */
+    bool contains(uint32_t v) const { return membership_.get(v); }
+
+    /**
+     * @brief Get the local ID of the passed vertex of the parent.
+     *
+     * @param v a uint32_t indicating the parent ID of a vertex.
+     * @return a uint32_t indicating its local ID, or NO_VERTEX if the vertex
+     * is not in the view.
+     */
+    uint32_t toLocal(uint32_t v) const {
+      if (!contains(v)) return NO_VERTEX;
+
+      uint64_t lower = membership_.word(v / 64) &
+                       ((uint64_t(1) << (v % 64)) - 1);
+      return ranks_[v / 64] + __builtin_popcountll(lower);
+    }
+
+    /**
+     * @brief Get the parent ID of the passed vertex of the view.
+     *
+     * @param v a uint32_t indicating the local ID of a vertex.
+     * @return a uint32_t indicating its parent ID.
+     */
+    uint32_t toParent(uint32_t v) const { return members_[v]; }
+
+    /**
+     * @brief Get the parent IDs of every vertex in the view, in order of
+     * local ID.
+     *
+     * @return a const std::vector<uint32_t>& of parent IDs.
+     */
+    const std::vector<uint32_t>& members() const { return members_; }
+
+    /**
+     * @brief Count the edges of the passed parent graph within the view.
+     *
+     * @param parent the CSRGraph this view was taken of.
+     * @return a uint64_t indicating the number of edges.
+     */
+    uint64_t countEdges(const CSRGraph& parent) const;
+
+    /**
+     * @brief Build a standalone CSRGraph of the subgraph, in which every
+     * vertex has its local ID and keeps the order of its edges in the parent.
+     * Vertex degrees and then neighbor ranges are filled in parallel, in
+     * blocks of vertices handed out to num_threads threads.
+     *
+     * @param parent the CSRGraph this view was taken of.
+     * @param num_threads an int indicating the number of threads to use.
+     * @return a CSRGraph of the induced subgraph.
+     */
+    CSRGraph materialize(const CSRGraph& parent, int num_threads=1) const;
+  private:
+    /**
+     * @brief Which vertices of the parent are in the view.
+     */
+    Bitmap membership_;
+
+    /**
+     * @brief The number of members in all words of membership_ before each
+     * word.
+     */
+    std::vector<uint32_t> ranks_;
+
+    /**
+     * @brief The parent ID of every member, indexed by local ID.
+     */
+    std::vector<uint32_t> members_;
+};
@@ -0,0 +1,353 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "algorithms/indexed_heap.h"
+#include "algorithms/bucket_queue.h"
+#include "algorithms/radix_heap.h"
+#include "core/csr_graph.h"
+
+/**
+ * @brief Holds all of the mutable per-vertex state used while running a single
+ * source shortest path search and Brandes' dependency accumulation, indexed by
+ * dense vertex ID. Keeping this state outside of the graph means the graph can
+ * be shared read-only between threads, with each thread owning its own
+ * TraversalWorkspace.
+ *
+ * The predecessors of each vertex on shortest paths from the source are kept
+ * in one flat array. A vertex can have at most one predecessor per incident
+ * edge, so the predecessors of vertex v are given the slots
+ * [offset(v), offset(v) + degree(v)) of that array, mirroring the layout of
+ * the neighbor array of a CSRGraph.
+ *
+ * Every vertex carries the epoch in which its state was last written. Starting
+ * a new search only advances the current epoch, and state stamped with an
+ * older epoch reads as if it had just been reset. The state of a vertex is
+ * only cleared when a search first writes to it, so a search never pays for
+ * the vertices it does not reach.
+ */
+class TraversalWorkspace {
+  public:
+    /**
+     * @brief The distance of a vertex that has not been reached.
+     */
+    static constexpr uint64_t UNREACHED = 0xFFFFFFFFFFFFFFFF;
+
+    /**
+     * @brief The parent of a vertex that has no parent.
+     */
+    static constexpr uint32_t NO_VERTEX = 0xFFFFFFFF;
+
+    /**
+     * @brief Construct a new TraversalWorkspace sized for the passed graph.
+     *
+     * @param graph a CSRGraph that this workspace will be used to search.
+     */
+    explicit TraversalWorkspace(const CSRGraph& graph);
+
+    /**
+     * @brief Invalidate the state of every vertex so that a new search can 
+     * begin. This takes constant time except once every 2^32 calls, when the
+     * epoch counter wraps around and every stamp is cleared.
+     */
+    void reset();
+
+    /**
+     * @brief Get the number of vertices this workspace holds state for.
+     *
+     * @return a uint32_t indicating the number of vertices.
+     */
+    uint32_t size() const { return states_.size(); }
+
+    /**
+     * @brief Get the distance from the source of the current search to the
+     * passed vertex.
+     *
+     * @param v a uint32_t indicating the ID of a vertex.
+     * @return a uint64_t indicating the distance, or UNREACHED.
+     */
+    uint64_t getDistance(uint32_t v) const {
+      return isCurrent(v) ? states_[v].distance : UNREACHED;
+    }
+
+    /**
+     * @brief Set the distance from the source of the current search to the
+     * passed vertex.
+     *
+     * @param v a uint32_t indicating the ID of a vertex.
+     * @param distance a uint64_t indicating the new distance.
+     */
+    void setDistance(uint32_t v, uint64_t distance) {
+      touch(v).distance = distance;
+    }
+
+    /**
+     * @brief Get the predecessor of the passed vertex on some shortest path
+     * from the source of the current search.
+     *
+     * @param v a uint32_t indicating the ID of a vertex.
+     * @return a uint32_t indicating the ID of the parent, or NO_VERTEX.
+     */
+    uint32_t getParent(uint32_t v) const {
+      return isCurrent(v) ? states_[v].parent : NO_VERTEX;
+    }
+
+    /**
+     * @brief Set the predecessor of the passed vertex on some shortest path
+     * from the source of the current search.
+     *
+     * @param v a uint32_t indicating the ID of a vertex.
+     * @param parent a uint32_t indicating the ID of the parent.
+     */
+    void setParent(uint32_t v, uint32_t parent) { touch(v).parent = parent; }
+
+    /**
+     * @brief Get whether or not the passed vertex has been settled in the
+     * current search.
+     *
+     * @param v a uint32_t indicating the ID of a vertex.
+     * @return true if the vertex HAS been settled.
+     * @return false if the vertex has NOT been settled.
+     */
+    bool wasExplored(uint32_t v) const {
+      return isCurrent(v) && states_[v].explored;
+    }
+
+    /**
+     * @brief Mark the passed vertex as settled in the current search and
+     * append it to the order in which vertices were settled.
+     *
+     * @param v a uint32_t indicating the ID of a vertex.
+     */
+    void settle(uint32_t v) {
+      touch(v).explored = true;
+      settled_.push_back(v);
+    }
+
+    /**
+     * @brief Get every vertex settled in the current search in the order they
+     * were settled, which is in order of non-decreasing distance.
+     *
+     * @return a const std::vector<uint32_t>& of settled vertex IDs.
+     */
+    const std::vector<uint32_t>& getSettledOrder() const { return settled_; }
+
+    /**
+     * @brief Get whether or not the passed vertex is one of the targets of the
+     * current search.
+     *
+     * @param v a uint32_t indicating the ID of a vertex.
+     * @return true if the vertex IS a target.
+     * @return false if the vertex is NOT a target.
+     */
+    bool isTarget(uint32_t v) const {
+      return isCurrent(v) && states_[v].target;
+    }
+
+    /**
+     * @brief Mark the passed vertex as a target of the current search.
+     *
+     * @param v a uint32_t indicating the ID of a vertex.
+     */
+    void markTarget(uint32_t v) { touch(v).target = true; }
+
+    /**
+     * @brief Get the number of shortest paths from the source of the current
+     * search to the passed vertex.
+     *
+     * @param v a uint32_t indicating the ID of a vertex.
+     * @return a double indicating the number of shortest paths.
+     */
+    double getPathCount(uint32_t v) const {
+      return isCurrent(v) ? states_[v].path_count : 0.0;
+    }
+
+    /**
+     * @brief Set the number of shortest paths from the source of the current
+     * search to the passed vertex.
+     *
+     * @param v a uint32_t indicating the ID of a vertex.
+     * @param count a double indicating the number of shortest paths.
+     */
+    void setPathCount(uint32_t v, double count) {
+      touch(v).path_count = count;
+    }
+
+    /**
+     * @brief Get the dependency of the source of the current search on the
+     * passed vertex, as used in Brandes' algorithm.
+     *
+     * @param v a uint32_t indicating the ID of a vertex.
+     * @return a double indicating the dependency.
+     */
+    double getDependency(uint32_t v) const {
+      return isCurrent(v) ? states_[v].dependency : 0.0;
+    }
+
+    /**
+     * @brief Increment the dependency of the source of the current search on
+     * the passed vertex, as used in Brandes' algorithm.
+     *
+     * @param v a uint32_t indicating the ID of a vertex.
+     * @param amount a double to add to the dependency.
+     */
+    void incrementDependency(uint32_t v, double amount) {
+      touch(v).dependency += amount;
+    }
+
+    /**
+     * @brief Record that the passed parent precedes the passed vertex on some
+     * shortest path from the source of the current search.
+     *
+     * @param v a uint32_t indicating the ID of a vertex.
+     * @param parent a uint32_t indicating the ID of the predecessor.
+     */
+    void addPredecessor(uint32_t v, uint32_t parent) {
+      predecessors_[predecessor_offsets_[v] + touch(v).predecessor_count++] = 
+        parent;
+    }
+
+    /**
+     * @brief Forget every predecessor recorded for the passed vertex. Used
+     * when a strictly shorter path to the vertex is found.
+     *
+     * @param v a uint32_t indicating the ID of a vertex.
+     */
+    void clearPredecessors(uint32_t v) { touch(v).predecessor_count = 0; }
+
+    /**
+     * @brief Get a pointer to the first predecessor of the passed vertex.
+     *
+     * @param v a uint32_t indicating the ID of a vertex.
+     * @return a const uint32_t* to the first predecessor ID.
+     */
+    const uint32_t* predecessorsBegin(uint32_t v) const {
+      return predecessors_.data() + predecessor_offsets_[v];
+    }
+
+    /**
+     * @brief Get a pointer one past the last predecessor of the passed vertex.
+     *
+     * @param v a uint32_t indicating the ID of a vertex.
+     * @return a const uint32_t* one past the last predecessor ID.
+     */
+    const uint32_t* predecessorsEnd(uint32_t v) const {
+      return predecessorsBegin(v) + 
+        (isCurrent(v) ? states_[v].predecessor_count : 0);
+    }
+
+    /**
+     * @brief Get the indexed heap searches with this workspace may use as
+     * their priority queue. The heap is empty whenever a search is not
+     * running.
+     *
+     * @return an IndexedHeap& that can hold every vertex of the graph.
+     */
+    IndexedHeap& getHeap() { return heap_; }
+
+    /**
+     * @brief Get the radix heap searches with this workspace may use as their
+     * priority queue.
+     *
+     * @return a RadixHeap& owned by this workspace.
+     */
+    RadixHeap& getRadixHeap() { return radix_heap_; }
+
+    /**
+     * @brief Get the bucket queue searches with this workspace may use as
+     * their priority queue, making sure it has enough buckets for edges of
+     * the passed weight. The buckets are only allocated the first time this is
+     * called.
+     *
+     * @param max_weight a uint64_t indicating the largest edge weight of the
+     * graph, which must be at most BucketQueue::MAX_WEIGHT.
+     * @return a BucketQueue& owned by this workspace.
+     */
+    BucketQueue& getBucketQueue(uint64_t max_weight) {
+      if (bucket_queue_max_weight_ < max_weight) {
+        bucket_queue_ = BucketQueue(max_weight);
+        bucket_queue_max_weight_ = max_weight;
+      }
+
+      return bucket_queue_;
+    }
+  private:
+    /**
+     * @brief The state of a single vertex, kept together so that relaxing an
+     * edge touches one cache line per vertex.
+     */
+    struct VertexState {
+      uint64_t distance;
+      double path_count;
+      double dependency;
+      uint32_t parent;
+      uint32_t predecessor_count;
+      uint32_t epoch;
+      bool explored;
+      bool target;
+    };
+
+    /**
+     * @brief Check whether the state of the passed vertex was written in the
+     * current search.
+     */
+    bool isCurrent(uint32_t v) const { return states_[v].epoch == epoch_; }
+
+    /**
+     * @brief Get the state of the passed vertex for writing, first clearing
+     * it if it was left over from an earlier search.
+     */
+    VertexState& touch(uint32_t v) {
+      VertexState& state = states_[v];
+      if (state.epoch != epoch_) {
+        state = {UNREACHED, 0.0, 0.0, NO_VERTEX, 0, epoch_, false, false};
+      }
+      return state;
+    }
+
+    /**
+     * @brief The state of each vertex, indexed by vertex ID.
+     */
+    std::vector<VertexState> states_;
+
+    /**
+     * @brief The epoch of the current search. Stamps never equal 0 while a 
+     * search is running, so a zeroed stamp always reads as stale.
+     */
+    uint32_t epoch_;
+
+    /**
+     * @brief The first slot of each vertex in predecessors_.
+     */
+    std::vector<uint64_t> predecessor_offsets_;
+
+    /**
+     * @brief The predecessors of every vertex, stored back to back.
+     */
+    std::vector<uint32_t> predecessors_;
+
+    /**
+     * @brief The vertices settled in the current search, in settle order.
+     */
+    std::vector<uint32_t> settled_;
+
+    /**
+     * @brief The priority queue reused by every search with this workspace.
+     */
+    IndexedHeap heap_;
+
+    /**
+     * @brief The radix heap reused by every search with this workspace.
+     */
+    RadixHeap radix_heap_;
+
+    /**
+     * @brief The bucket queue reused by every search with this workspace.
+     */
+    BucketQueue bucket_queue_;
+
+    /**
+     * @brief The largest edge weight bucket_queue_ has buckets for.
+     */
+    uint64_t bucket_queue_max_weight_;
+};
@@ -0,0 +1,137 @@
+#pragma once
+#include <string_view>
+#include <iostream>
+#include <cstdint>
+#include <cstring>
+#include <string>
+#include <array>
+
+/**
+ * @brief This class represents a 20 byte etherium blockchain address in its
+ * packed binary form. Addresses are decoded from their "0x..." hexadecimal
+ * form once when a graph is loaded and are only encoded back into hexadecimal
+ * when they are printed. Compared to storing the 42 character hexadecimal
+ * string, this halves the memory used per address, avoids a heap allocation
+ * per address, and makes comparing and hashing addresses much cheaper.
+ *
+ * Hexadecimal addresses shorter than 40 digits are treated as numbers and are
+ * padded with leading zeros, so "0x1" and "0x0...01" are the same address.
+ */
+class Address {
+  public:
+    /**
+     * @brief The number of bytes in an etherium address.
+     */
+    static const size_t SIZE = 20;
+
+    /**
+     * @brief Construct a new Address object where every byte is zero.
+     */
+    Address() : bytes_() { }
+
+    /**
+     * @brief Decode a hexadecimal address with an optional "0x" prefix into
+     * its packed binary form. Both lowercase and uppercase digits are allowed.
+     *
+     * @param hex a std::string_view containing at most 40 hexadecimal digits.
+     * @param address an Address to fill with the decoded address.
+     * @return true if the passed string was a valid address.
+     * @return false if the passed string was empty, too long, or contained a
+     * character that is not a hexadecimal digit, in which case the passed
+     * address is left unchanged.
+     */
+    static bool fromHex(std::string_view hex, Address& address);
+
+    /**
+     * @brief Construct an address from its packed binary form.
+     *
+     * @param bytes a pointer to the SIZE bytes of an address, most significant
+     * byte first.
+     * @return the Address stored in the passed bytes.
+     */
+    static Address fromBytes(const uint8_t* bytes) {
+      Address address;
+      memcpy(address.bytes_.data(), bytes, SIZE);
+      return address;
+    }
+
+    /**
+     * @brief Encode this address in its lowercase "0x..." hexadecimal form
+     * with all 40 digits.
+     *
+     * @return a std::string containing the hexadecimal form of this address.
+     */
+    std::string toHex() const;
+
+    /**
+     * @brief Get the packed binary form of this address.
+     *
+     * @return a const uint8_t* pointing to the SIZE bytes of this address.
+     */
+    const uint8_t* data() const { return bytes_.data(); }
+
+    /**
+     * @brief Check whether two addresses are the same.
+     */
+    bool operator==(const Address& other) const {
+      return bytes_ == other.bytes_;
+    }
+
+    /**
+     * @brief Check whether two addresses are different.
+     */
+    bool operator!=(const Address& other) const {
+      return bytes_ != other.bytes_;
+    }
+
+    /**
+     * @brief Order addresses by their numeric value.
+     */
+    bool operator<(const Address& other) const {
+      return bytes_ < other.bytes_;
+    }
+
+    /**
+     * @brief Defines the insertion operator for the Address class so that
+     * addresses are printed in their hexadecimal form.
+     *
+     * @param os the ostream to add this Address to.
+     * @param address the Address to add to the ostream.
+     * @return std::ostream& the passed ostream after it has been modified.
+     */
+    friend std::ostream& operator<<(std::ostream& os, const Address& address);
+  private:
+    /**
+     * @brief The packed binary form of this address, most significant byte
+     * first.
+     */
+    std::array<uint8_t, SIZE> bytes_;
+};
+
+/**
+ * @brief A hash function for Address objects used to index hash maps by
+ * address. Etherium addresses are derived from a cryptographic hash, so their
+ * bytes are already uniformly distributed. The hash simply folds the 20 bytes
+ * into a single word with a multiplicative mix, which avoids hashing the
+ * address byte by byte while still spreading out short, non-random addresses
+ * like "0x1".
+ */
+struct AddressHash {
+  /**
+   * @brief Hash the passed address.
+   *
+   * @param address the Address to hash.
+   * @return a size_t hash of the passed address.
+   */
+  size_t operator()(const Address& address) const {
+    uint64_t high, middle;
+    uint32_t low;
+    memcpy(&high, address.data(), sizeof(high));
+    memcpy(&middle, address.data() + 8, sizeof(middle));
+    memcpy(&low, address.data() + 16, sizeof(low));
+
+    uint64_t h = (high * 0x9E3779B97F4A7C15ULL) ^ (middle + low);
+    h *= 0xC2B2AE3D27D4EB4FULL;
+    return static_cast<size_t>(h ^ (h >> 32));
+  }
+};
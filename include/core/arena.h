@@ -0,0 +1,132 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+#include <new>
+
+/**
+ * @brief Owns the storage of many objects of a single type. Objects are placed
+ * one after another in large blocks in the order they are created, so objects
+ * created together end up next to each other in memory. Objects are never
+ * moved once created, so pointers to them stay valid until the arena is
+ * cleared or destroyed. Individual objects cannot be freed; every object is
+ * destroyed at once, in creation order, by `clear` or the destructor.
+ *
+ * Blocks grow geometrically, so creating n objects performs O(log n)
+ * allocations. Calling `reserve` first lets a known number of objects be
+ * placed in a single block.
+ *
+ * @tparam T the type of the objects owned by the arena.
+ */
+template <typename T>
+class Arena {
+  public:
+    /**
+     * @brief The number of objects that fit in the first block of an arena.
+     */
+    static const size_t MIN_BLOCK_SIZE = 1024;
+
+    /**
+     * @brief Construct a new empty Arena that has not allocated any memory.
+     */
+    Arena() : blocks_(), size_(0) { }
+
+    Arena(const Arena&) = delete;
+    Arena& operator=(const Arena&) = delete;
+
+    /**
+     * @brief Destroy every object in this arena and free its blocks.
+     */
+    ~Arena() { clear(); }
+
+    /**
+     * @brief Construct a new object in this arena.
+     *
+     * @param args the arguments passed to the constructor of T.
+     * @return a T* to the new object, which is owned by this arena.
+     */
+    template <typename... Args>
+    T* create(Args&&... args) {
+      if (blocks_.empty() || blocks_.back().used == blocks_.back().capacity) {
+        addBlock(std::max(MIN_BLOCK_SIZE, size_));
+      }
+
+      Block& block = blocks_.back();
+      T* object = new (block.data + block.used) T(std::forward<Args>(args)...);
+      ++block.used;
+      ++size_;
+      return object;
+    }
+
+    /**
+     * @brief Make sure the next count objects created are placed in the
+     * current block, allocating one new block large enough to hold them if
+     * they do not fit.
+     *
+     * @param count a size_t indicating the number of objects about to be
+     * created.
+     */
+    void reserve(size_t count) {
+      if (!blocks_.empty() &&
+          blocks_.back().capacity - blocks_.back().used >= count) {
+        return;
+      }
+
+      addBlock(std::max(MIN_BLOCK_SIZE, count));
+    }
+
+    /**
+     * @brief Destroy every object in this arena in the order they were created
+     * and free every block.
+     */
+    void clear() {
+      for (Block& block : blocks_) {
+        for (size_t i = 0; i < block.used; ++i) {
+          block.data[i].~T();
+        }
+
+        ::operator delete(static_cast<void*>(block.data));
+      }
+
+      blocks_.clear();
+      size_ = 0;
+    }
+
+    /**
+     * @brief Get the number of objects in this arena.
+     *
+     * @return a size_t indicating the number of objects.
+     */
+    size_t size() const { return size_; }
+  private:
+    /**
+     * @brief A contiguous run of storage for capacity objects, of which the
+     * first used are constructed.
+     */
+    struct Block {
+      T* data;
+      size_t used;
+      size_t capacity;
+    };
+
+    /**
+     * @brief Allocate a new block that holds capacity objects and make it the
+     * block new objects are placed in. Unused space in the previous block is
+     * left empty.
+     */
+    void addBlock(size_t capacity) {
+      T* data = static_cast<T*>(::operator new(capacity * sizeof(T)));
+      blocks_.push_back({data, 0, capacity});
+    }
+
+    /**
+     * @brief Every block allocated by this arena in allocation order.
+     */
+    std::vector<Block> blocks_;
+
+    /**
+     * @brief The total number of objects in this arena.
+     */
+    size_t size_;
+};
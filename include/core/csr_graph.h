@@ -0,0 +1,148 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "address.h"
+#include "graph.h"
+
+/**
+ * @brief An immutable compressed sparse row (CSR) representation of a Graph.
+ * Vertices are identified by the same dense 32-bit IDs as the Graph it was
+ * built from. The neighbors of every vertex are stored back to back in a
+ * single contiguous array, and the neighbors of vertex v occupy the range
+ * [offset(v), offset(v + 1)) of that array. A parallel array holds the weight
+ * (the gas used by the transaction) of the edge leading to each neighbor.
+ *
+ * Because every edge is undirected, each Edge of the Graph appears twice: once
+ * in the neighbor range of its source and once in the neighbor range of its
+ * destination. Neighbor ranges keep the order of each vertex's incident edges
+ * in the Graph, so traversals over a CSRGraph visit vertices in the same order
+ * as traversals over the Graph.
+ *
+ * Traversing an edge only reads two adjacent arrays, which avoids the chain of
+ * dependent pointer loads needed to walk Vertex* -> Edge* -> Vertex*.
+ */
+class CSRGraph {
+  public:
+    /**
+     * @brief Construct an empty CSRGraph with no vertices and no edges.
+     */
+    CSRGraph();
+
+    /**
+     * @brief Construct a CSRGraph with the same vertices, edges, and vertex IDs
+     * as the passed Graph.
+     *
+     * @param graph a Graph to build the compressed representation of.
+     */
+    explicit CSRGraph(const Graph& graph);
+
+    /**
+     * @brief Construct a CSRGraph from arrays that are already laid out as 
+     * described above, such as those of a subgraph built from a larger 
+     * CSRGraph. Every edge must appear in the neighbor range of both of its
+     * endpoints.
+     *
+     * @param offsets numVertices() + 1 indices into neighbors and weights,
+     * starting at 0.
+     * @param neighbors the IDs of the neighbors of every vertex.
+     * @param weights the weight of the edge leading to each neighbor.
+     * @param addresses the blockchain address of every vertex.
+     */
+    CSRGraph(std::vector<uint64_t> offsets, std::vector<uint32_t> neighbors,
+             std::vector<uint64_t> weights, std::vector<Address> addresses);
+
+    /**
+     * @brief Get the number of vertices in this graph.
+     *
+     * @return a uint32_t indicating the number of vertices.
+     */
+    uint32_t numVertices() const { return addresses_.size(); }
+
+    /**
+     * @brief Get the number of undirected edges in this graph.
+     *
+     * @return a uint64_t indicating the number of edges.
+     */
+    uint64_t numEdges() const { return neighbors_.size() / 2; }
+
+    /**
+     * @brief Get the index into the neighbor and weight arrays at which the
+     * neighbors of the passed vertex begin. Passing `numVertices()` returns
+     * the total length of the neighbor array.
+     *
+     * @param v a uint32_t indicating the ID of a vertex.
+     * @return a uint64_t indicating the first neighbor index of the vertex.
+     */
+    uint64_t offset(uint32_t v) const { return offsets_[v]; }
+
+    /**
+     * @brief Get the number of edges incident to the passed vertex.
+     *
+     * @param v a uint32_t indicating the ID of a vertex.
+     * @return a uint32_t indicating the degree of the vertex.
+     */
+    uint32_t degree(uint32_t v) const { return offsets_[v + 1] - offsets_[v]; }
+
+    /**
+     * @brief Get the ID of the vertex at the passed index of the neighbor
+     * array.
+     *
+     * @param index a uint64_t in the range [offset(v), offset(v + 1)) for
+     * some vertex v.
+     * @return a uint32_t indicating the ID of the neighbor.
+     */
+    uint32_t neighbor(uint64_t index) const { return neighbors_[index]; }
+
+    /**
+     * @brief Get the weight of the edge at the passed index of the neighbor
+     * array, which is the gas used by the transaction the edge represents.
+     *
+     * @param index a uint64_t in the range [offset(v), offset(v + 1)) for
+     * some vertex v.
+     * @return a uint64_t indicating the weight of the edge.
+     */
+    uint64_t weight(uint64_t index) const { return weights_[index]; }
+
+    /**
+     * @brief Get the largest weight of any edge in this graph.
+     *
+     * @return a uint64_t indicating the largest weight, or 0 if there are no
+     * edges.
+     */
+    uint64_t maxWeight() const { return max_weight_; }
+
+    /**
+     * @brief Get the blockchain address of the passed vertex.
+     *
+     * @param v a uint32_t indicating the ID of a vertex.
+     * @return a const Address& indicating the address of the vertex.
+     */
+    const Address& getAddress(uint32_t v) const { return addresses_[v]; }
+  private:
+    /**
+     * @brief numVertices() + 1 indices into the neighbor and weight arrays.
+     * The neighbors of vertex v are stored in [offsets_[v], offsets_[v + 1]).
+     */
+    std::vector<uint64_t> offsets_;
+
+    /**
+     * @brief The IDs of the neighbors of every vertex, stored back to back.
+     */
+    std::vector<uint32_t> neighbors_;
+
+    /**
+     * @brief The weight of the edge leading to each neighbor in neighbors_.
+     */
+    std::vector<uint64_t> weights_;
+
+    /**
+     * @brief The blockchain address of every vertex, indexed by vertex ID.
+     */
+    std::vector<Address> addresses_;
+
+    /**
+     * @brief The largest weight in weights_.
+     */
+    uint64_t max_weight_;
+};
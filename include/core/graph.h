@@ -1,11 +1,14 @@
 #pragma once
 
 #include <unordered_map>
+#include <string_view>
 #include <vector>
 #include <string>
-#include <stack>
 
+#include "union_find.h"
+#include "address.h"
 #include "vertex.h"
+#include "arena.h"
 #include "edge.h"
 
 /**
@@ -13,6 +16,10 @@
  * graph implementation. Vertices are indexed by their associated blockchain 
  * address in the unordered map used to store all vertices. Edges are simply 
  * stored in a vector with arbitrary ordering.
+ *
+ * The Vertex and Edge objects themselves live in arenas owned by the graph, so
+ * objects added one after another sit next to each other in memory and the 
+ * whole graph is freed in a handful of large deallocations.
  */
 class Graph {
   public:
@@ -64,45 +71,112 @@ class Graph {
 
     /**
      * @brief Construct a new Vertex object and adds it to the graph. By default 
-     * Vertices are initialized with an empty list of indicent edges. 
+     * Vertices are initialized with an empty list of indicent edges. Each new
+     * Vertex receives the next unused dense integer ID. If the graph already
+     * contains a vertex with the passed address, no new vertex is created.
      * 
-     * @param address a string indicating the address of the individual that 
+     * @param address an Address indicating the address of the individual that 
      * this Vertex represents. 
-     * @return a Vertex* pointing to the newly created Vertex.
+     * @return a Vertex* pointing to the newly created Vertex, or to the 
+     * existing Vertex with the passed address.
      */
-    Vertex* addVertex(const std::string& address);
+    Vertex* addVertex(const Address& address);
+
+    /**
+     * @brief Construct a new Vertex object from a hexadecimal address and adds
+     * it to the graph. By default Vertices are initialized with an empty list 
+     * of indicent edges. 
+     * 
+     * @param address a string indicating the hexadecimal address of the 
+     * individual that this Vertex represents. 
+     * @return a Vertex* pointing to the newly created Vertex, or NULL if the 
+     * passed string is not a valid address.
+     */
+    Vertex* addVertex(std::string_view address);
+
+    /**
+     * @brief Reserve space for the given number of vertices and edges so that
+     * adding them does not repeatedly grow the underlying containers, and so 
+     * that the new vertices and edges are each placed in a single arena block.
+     * Used when the size of the graph is known before it is built.
+     * 
+     * @param num_vertices a size_t indicating the expected number of vertices.
+     * @param num_edges a size_t indicating the expected number of edges.
+     */
+    void reserve(size_t num_vertices, size_t num_edges);
 
     /**
      * @brief Get the vertex associated with the passed address.
      * 
-     * @param address a string indicating the blockchain address with which to 
-     * search for the associated vertex in this graph.
+     * @param address an Address indicating the blockchain address with which 
+     * to search for the associated vertex in this graph.
      * @return a Vertex* representing the individual associated with the passed 
      * address. If the vertex does not exist in the graph, returns NULL.
      */
-    Vertex* getVertex(const std::string& address) const;
+    Vertex* getVertex(const Address& address) const;
+
+    /**
+     * @brief Get the vertex associated with the passed hexadecimal address.
+     * 
+     * @param address a string indicating the hexadecimal blockchain address 
+     * with which to search for the associated vertex in this graph.
+     * @return a Vertex* representing the individual associated with the passed 
+     * address. If the vertex does not exist in the graph or the passed string 
+     * is not a valid address, returns NULL.
+     */
+    Vertex* getVertex(std::string_view address) const;
 
     /**
      * @brief Check if the graph contains a vertex associated with the passed 
      * address.
      * 
-     * @param address a string indicating the blockchain address with which to 
-     * search for the associated vertex in this graph.
+     * @param address an Address indicating the blockchain address with which 
+     * to search for the associated vertex in this graph.
      * @return true if this graph CONTAINS a vertex associated with the passed 
      * address.
      * @return false if this graph DOES NOT contain a vertex associated with the
      * passed address.
      */
-    bool containsVertex(const std::string& address) const;
+    bool containsVertex(const Address& address) const;
+
+    /**
+     * @brief Check if the graph contains a vertex associated with the passed 
+     * hexadecimal address.
+     * 
+     * @param address a string indicating the hexadecimal blockchain address 
+     * with which to search for the associated vertex in this graph.
+     * @return true if this graph CONTAINS a vertex associated with the passed 
+     * address.
+     * @return false if this graph DOES NOT contain a vertex associated with the
+     * passed address, or if the passed string is not a valid address.
+     */
+    bool containsVertex(std::string_view address) const;
 
     /**
      * @brief Get all the vertices in this graph. Returns a const reference to 
-     * the std::unordered_map<std::string, Vertex*> of vertices. 
+     * the std::unordered_map<Address, Vertex*, AddressHash> of vertices. 
+     * 
+     * @return a std::unordered_map<Address, Vertex*, AddressHash> containing 
+     * all the vertices in this graph, indexed by the associated blockchain 
+     * addresses.
+     */
+    const std::unordered_map<Address, Vertex*, AddressHash>& getVertices() const;
+
+    /**
+     * @brief Get the vertex with the passed dense integer ID. Vertex IDs range 
+     * from 0 to `numVertices() - 1` in the order the vertices were added.
+     * 
+     * @param id a uint32_t indicating the ID of the vertex to get.
+     * @return a Vertex* with the passed ID.
+     */
+    Vertex* getVertexById(uint32_t id) const { return ordered_vertices_[id]; }
+
+    /**
+     * @brief Get the number of vertices in this graph.
      * 
-     * @return a std::unordered_map<std::string, Vertex*> containing all the
-     * vertices in this graph, indexed by the associated blockchain addresses.
+     * @return a uint32_t indicating the number of vertices in this graph.
      */
-    const std::unordered_map<std::string, Vertex*>& getVertices() const;
+    uint32_t numVertices() const { return ordered_vertices_.size(); }
 
     /**
      * @brief Get all the edges in this graph.
@@ -113,54 +187,74 @@ class Graph {
     const std::vector<Edge*>& getEdges() const;
 
     /**
-     * @brief Push a Vertex* to the stack of vertices that are ordered by 
-     * distance from some arbitrary start vertex after running Dijkstra's 
-     * algorithm on this graph.
+     * @brief Start keeping track of the connected components of this graph. 
+     * The components of the vertices and edges already in the graph are found
+     * with a single pass over its edges. From then on, every vertex and edge
+     * added updates the components as it is added, so the functions below 
+     * answer without traversing the graph. Does nothing if the components are
+     * already being tracked.
+     */
+    void trackComponents();
+
+    /**
+     * @brief Check whether the connected components of this graph are being
+     * tracked.
      * 
-     * @param v a Vertex* to add to the stack.
+     * @return true if `trackComponents` WAS called on this graph.
+     * @return false if `trackComponents` was NOT called on this graph.
      */
-    void pushDistanceOrderedVertex(Vertex* v);
+    bool tracksComponents() const { return tracks_components_; }
 
     /**
-     * @brief Pop and return the Vertex* at the top of the stack of vertices 
-     * that are ordered by distance from some arbitrary start vertex after 
-     * running Dijkstra's algorithm on this graph.
+     * @brief Get the number of connected components in this graph. The 
+     * components must be tracked.
      * 
-     * @return the Vertex* at the top of the stack.
+     * @return a uint32_t indicating the number of connected components.
      */
-    Vertex* popDistanceOrderedVertex();
+    uint32_t numComponents() const { return components_.numSets(); }
 
     /**
-     * @brief Reset and empty the stack of vertices that are ordered by distance 
-     * from some arbitrary start vertex after running Dijkstra's algorithm on 
-     * this graph. Note that this DOES NOT destruct the Vertex* in the stack.
+     * @brief Get the connected component containing the passed vertex, as the
+     * ID of a vertex that represents the component. Two vertices are in the 
+     * same component exactly when they have the same representative. The 
+     * representative of a component may change when edges are added. The 
+     * components must be tracked.
+     * 
+     * @param v a Vertex* in this graph.
+     * @return a uint32_t indicating the ID of the representative vertex.
      */
-    void resetDistanceOrderedVertices();
+    uint32_t getComponent(const Vertex* v) const { 
+      return components_.find(v->getId()); 
+    }
 
     /**
-     * @brief Checks whether or not the stack of vertices that are ordered by 
-     * distance from some arbitrary start vertex after running Dijkstra's 
-     * algorithm on this graph contains any vertices.
+     * @brief Get the number of vertices in the connected component containing
+     * the passed vertex. The components must be tracked.
      * 
-     * @return true if the stack contains any vertices.
-     * @return false if the stack is empty.
+     * @param v a Vertex* in this graph.
+     * @return a uint32_t indicating the number of vertices.
      */
-    bool hasDistanceOrderedVertices() const;
+    uint32_t getComponentSize(const Vertex* v) const { 
+      return components_.setSize(v->getId()); 
+    }
 
     /**
-     * @brief Incremene the counter tracking the number of unique shortest paths 
-     * in this graph.
+     * @brief Get the number of vertices in every connected component of this
+     * graph, in order of the lowest vertex ID in each component. The 
+     * components must be tracked.
+     * 
+     * @return a std::vector<uint32_t> with one size per component.
      */
-    void incrementPathCounter() { ++path_counter_; }
-    
+    std::vector<uint32_t> getComponentSizes() const;
+
     /**
-     * @brief Get the number of unique paths after having computed the number
-     * while running Brandes' algorithm to compute betweenness centrality.
+     * @brief Get the vertices of the largest connected component of this
+     * graph, in order of vertex ID. The components must be tracked.
      * 
-     * @return A uint64_t indicating the number of unique shortest paths in this 
-     * graph.
+     * @return a std::vector<Vertex*> containing the vertices of the largest
+     * component, which is empty if the graph has no vertices.
      */
-    uint64_t getPathCounter() { return path_counter_; }
+    std::vector<Vertex*> getLargestComponent() const;
 
     /**
      * @brief Constructs a Graph with all edges and vertices allocated on the 
@@ -169,12 +263,60 @@ class Graph {
      * 
      * idx,from_address,to_address,truncated_value,gas,gas_price
      * 
+     * The file is memory mapped and each record is tokenized in place, so no 
+     * strings are allocated while parsing. Addresses are decoded into their 
+     * packed 20 byte form as they are parsed. Malformed records, including 
+     * records with invalid addresses are skipped. Unless printing is 
+     * suppressed, the time taken and the throughput of the load in MB/s are 
+     * printed.
+     * 
+     * If more than one thread is requested, the file is split into newline 
+     * aligned chunks that are tokenized in parallel into per-thread buffers. 
+     * The buffers are then merged in file order, so vertices and edges are 
+     * added in the same order no matter how many threads are used.
+     * 
      * @param path a string indicating the path to the CSV file to load.
      * @param suppress_print a bool indicating whether or not to suppress 
      * printing in this function.
+     * @param num_threads an int indicating the number of threads to tokenize
+     * the file with. Values less than or equal to 1 load on a single thread.
+     * @param track_components a bool indicating whether or not the connected
+     * components of the graph should be tracked as records are merged, as if
+     * by calling `trackComponents` on the empty graph.
      * @return Graph* a graph constructed from the data in the CSV file.
      */
-    static Graph* fromFile(const std::string& path, bool suppress_print=false);
+    static Graph* fromFile(const std::string& path, bool suppress_print=false,
+                           int num_threads=1, bool track_components=false);
+
+    /**
+     * @brief Write this graph to a versioned binary snapshot at the given path.
+     * A snapshot stores the vertex addresses, the adjacency lists, and the 
+     * attributes of every edge as flat arrays (refer to snapshot.h for the 
+     * exact layout) so that the graph can be loaded again without parsing a
+     * CSV file. Existing files at the given path are overwritten.
+     * 
+     * @param path a string indicating the path to write the snapshot to.
+     * @return true if the snapshot was written successfully.
+     * @return false if the file could not be opened or written.
+     */
+    bool toSnapshot(const std::string& path) const;
+
+    /**
+     * @brief Constructs a Graph with all edges and vertices allocated on the 
+     * heap by loading a binary snapshot written by `toSnapshot`. The snapshot 
+     * is memory mapped and its arrays are read in place. Vertices and edges 
+     * are added in the order they were written, so every adjacency list is 
+     * restored in its original order. If the file is not a snapshot, was 
+     * written with an unsupported version of the format, or is truncated, an 
+     * empty graph is returned.
+     * 
+     * @param path a string indicating the path to the snapshot to load.
+     * @param suppress_print a bool indicating whether or not to suppress 
+     * printing in this function.
+     * @return Graph* a graph constructed from the data in the snapshot.
+     */
+    static Graph* fromSnapshot(const std::string& path, 
+                               bool suppress_print=false);
 
     /**
      * @brief Constructs a Graph with all of the vertices in the passed vector.
@@ -195,24 +337,38 @@ class Graph {
     std::vector<Edge*> edges_;
 
     /**
-     * @brief A collection of all the vertices in this graph ordered by their 
+     * @brief A collection of all the vertices in this graph indexed by their 
      * associated address in the etherium blockchain.
      */
-    std::unordered_map<std::string, Vertex*> vertices_;
+    std::unordered_map<Address, Vertex*, AddressHash> vertices_;
+
+    /**
+     * @brief A collection of all the vertices in this graph indexed by their 
+     * dense integer IDs, which is also the order they were added in.
+     */
+    std::vector<Vertex*> ordered_vertices_;
+
+    /**
+     * @brief The storage of every Vertex in this graph, in ID order.
+     */
+    Arena<Vertex> vertex_arena_;
+
+    /**
+     * @brief The storage of every Edge in this graph, in the order the edges
+     * were added.
+     */
+    Arena<Edge> edge_arena_;
 
     /**
-     * @brief A stack of vertices that are inherently ordered by distance from
-     * some arbitrary start vertex after running Dijkstra's algorithm on this 
-     * graph. This stack is used in the accumulation stage of Brandes' algorithm
-     * to compute betweenness centrality.
+     * @brief The connected components of this graph over vertex IDs, which
+     * are only kept while tracks_components_ is set.
      */
-    std::stack<Vertex*> distance_ordered_vertices_;
+    UnionFind components_;
 
     /**
-     * @brief A uint64_t indicating the number of unique shortest paths in this 
-     * graph.
+     * @brief Whether or not components_ is updated as the graph grows.
      */
-    uint64_t path_counter_;
+    bool tracks_components_;
 
     /**
      * @brief Delete all of the associated Vertex objects and Edge objects 
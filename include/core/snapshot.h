@@ -0,0 +1,133 @@
+#pragma once
+#include <cstdint>
+#include <cstddef>
+#include <fstream>
+#include <vector>
+
+#include "utils/mapped_file.h"
+#include "address.h"
+
+/**
+ * @brief Describes the layout of a binary graph snapshot written by
+ * Graph::toSnapshot and read by Graph::fromSnapshot. A snapshot is a single
+ * SnapshotHeader followed by flat arrays in the order listed below. Every
+ * array begins on an 8 byte boundary so that the file can be memory mapped
+ * and each array read in place. All integers are stored in the byte order of
+ * the machine that wrote the snapshot.
+ *
+ * Version 1 of the format stored addresses as hexadecimal strings, using a
+ * uint64_t address_offsets[num_vertices + 1] array into a
+ * char address_chars[address_bytes] array in place of the addresses array
+ * below. Version 1 snapshots can still be read, but only version 2 snapshots
+ * are written.
+ *
+ *   uint8_t  addresses[num_vertices * Address::SIZE]
+ *   uint64_t adjacency_offsets[num_vertices + 1] (into adjacency)
+ *   uint32_t adjacency[2 * num_edges]            (incident edge indices)
+ *   uint32_t edge_source[num_edges]              (vertex indices)
+ *   uint32_t edge_destination[num_edges]         (vertex indices)
+ *   double   edge_value[num_edges]
+ *   uint64_t edge_gas[num_edges]
+ *   uint64_t edge_gas_price[num_edges]
+ */
+struct SnapshotHeader {
+  /**
+   * @brief Identifies the file as a graph snapshot. Always SNAPSHOT_MAGIC.
+   */
+  char magic[8];
+
+  /**
+   * @brief The version of the snapshot format. Readers reject snapshots with
+   * a version they do not understand.
+   */
+  uint32_t version;
+
+  /**
+   * @brief The size of this header in bytes. The first array begins here.
+   */
+  uint32_t header_size;
+
+  /**
+   * @brief The number of vertices stored in the snapshot.
+   */
+  uint64_t num_vertices;
+
+  /**
+   * @brief The number of edges stored in the snapshot.
+   */
+  uint64_t num_edges;
+
+  /**
+   * @brief The total number of bytes used to store every vertex address.
+   */
+  uint64_t address_bytes;
+
+  /**
+   * @brief Unused space reserved for future versions of the format.
+   */
+  uint64_t reserved[3];
+};
+
+/**
+ * @brief The magic bytes at the start of every graph snapshot.
+ */
+static const char SNAPSHOT_MAGIC[8] = {'G', 'T', 'H', 'S', 'N', 'A', 'P', '\0'};
+
+/**
+ * @brief The version of the snapshot format written by this build.
+ */
+static const uint32_t SNAPSHOT_VERSION = 2;
+
+/**
+ * @brief The oldest version of the snapshot format this build can still read.
+ */
+static const uint32_t SNAPSHOT_MIN_VERSION = 1;
+
+/**
+ * @brief Round the passed size up to the next multiple of 8 bytes. Used to
+ * place every array in a snapshot on an 8 byte boundary.
+ *
+ * @param size a size_t indicating a number of bytes.
+ * @return the smallest multiple of 8 that is greater than or equal to size.
+ */
+inline size_t snapshot_align(size_t size) {
+  return (size + 7) & ~static_cast<size_t>(7);
+}
+
+/**
+ * @brief Write the passed array to the passed stream followed by enough zero
+ * bytes to align the next array on an 8 byte boundary. Shared by every binary
+ * file format that follows the snapshot layout conventions.
+ */
+template <typename T>
+inline void snapshot_write_array(std::ofstream& of, 
+                                 const std::vector<T>& array) {
+  static const char padding[8] = {0};
+  size_t bytes = array.size() * sizeof(T);
+
+  of.write(reinterpret_cast<const char*>(array.data()), bytes);
+  of.write(padding, snapshot_align(bytes) - bytes);
+}
+
+/**
+ * @brief Point the passed pointer at an array of count elements that begins at
+ * the passed offset in the mapped snapshot, and advance the offset past the
+ * array and its padding.
+ *
+ * @return true if the entire array lies within the mapped snapshot.
+ */
+template <typename T>
+inline bool snapshot_read_array(const MappedFile& file, size_t& offset, 
+                                size_t count, const T*& array) {
+  // counts come from the file, so compare them without computing a size in
+  // bytes that could overflow
+  if (offset > file.size() || count > (file.size() - offset) / sizeof(T)) {
+    return false;
+  }
+
+  size_t bytes = count * sizeof(T);
+
+  array = reinterpret_cast<const T*>(file.data() + offset);
+  offset += snapshot_align(bytes);
+  return true;
+}
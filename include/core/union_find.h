@@ -0,0 +1,166 @@
+#pragma once
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+/**
+ * @brief A disjoint set forest over the integers [0, size()), which grows one
+ * singleton set at a time. Sets are merged by size, so every tree has a height
+ * of at most log2 of its size and a root can be found without modifying the
+ * forest. Merging also halves the paths it walks, which keeps the trees of
+ * sets that are merged often close to flat.
+ *
+ * The size of every set and the largest set are updated as sets are merged,
+ * so the number of sets, the size of any set, and the largest set are all
+ * available at any time without a pass over the elements.
+ */
+class UnionFind {
+  public:
+    /**
+     * @brief The value of largest for a forest without elements.
+     */
+    static constexpr uint32_t NO_ELEMENT = 0xFFFFFFFF;
+
+    /**
+     * @brief Construct a forest without any elements.
+     */
+    UnionFind() : parent_(), size_(), num_sets_(0), largest_(NO_ELEMENT) { }
+
+    /**
+     * @brief Get the number of elements in the forest.
+     *
+     * @return a uint32_t indicating the number of elements.
+     */
+    uint32_t size() const { return parent_.size(); }
+
+    /**
+     * @brief Get the number of disjoint sets in the forest.
+     *
+     * @return a uint32_t indicating the number of sets.
+     */
+    uint32_t numSets() const { return num_sets_; }
+
+    /**
+     * @brief Get the root of the set with the most elements. Ties go to the set
+     * that reached its size first.
+     *
+     * @return a uint32_t indicating the root of the largest set, or NO_ELEMENT
+     * if the forest is empty.
+     */
+    uint32_t largest() const { return largest_; }
+
+    /**
+     * @brief Reserve space for the passed number of elements.
+     *
+     * @param num_elements a size_t indicating the expected number of elements.
+     */
+    void reserve(size_t num_elements) {
+      parent_.reserve(num_elements);
+      size_.reserve(num_elements);
+    }
+
+    /**
+     * @brief Add a new element in a set of its own.
+     *
+     * @return a uint32_t indicating the new element, which is size() - 1.
+     */
+    uint32_t add() {
+      uint32_t x = parent_.size();
+      parent_.push_back(x);
+      size_.push_back(1);
+
+      ++num_sets_;
+      if (largest_ == NO_ELEMENT) largest_ = x;
+
+      return x;
+    }
+
+    /**
+     * @brief Find the root of the set containing the passed element. Two
+     * elements are in the same set exactly when they have the same root.
+     *
+     * @param x a uint32_t indicating an element.
+     * @return a uint32_t indicating the root of its set.
+     */
+    uint32_t find(uint32_t x) const {
+      while (parent_[x] != x) x = parent_[x];
+      return x;
+    }
+
+    /**
+     * @brief Get the number of elements in the set containing the passed
+     * element.
+     *
+     * @param x a uint32_t indicating an element.
+     * @return a uint32_t indicating the size of its set.
+     */
+    uint32_t setSize(uint32_t x) const { return size_[find(x)]; }
+
+    /**
+     * @brief Merge the sets containing the two passed elements, hooking the
+     * root of the smaller set below the root of the larger one.
+     *
+     * @param a a uint32_t indicating an element.
+     * @param b a uint32_t indicating an element.
+     * @return true if two different sets were merged.
+     * @return false if both elements were already in the same set.
+     */
+    bool unite(uint32_t a, uint32_t b) {
+      a = findAndHalve(a);
+      b = findAndHalve(b);
+      if (a == b) return false;
+
+      if (size_[a] < size_[b]) std::swap(a, b);
+      parent_[b] = a;
+      size_[a] += size_[b];
+      --num_sets_;
+
+      if (largest_ == b || size_[a] > size_[largest_]) largest_ = a;
+
+      return true;
+    }
+
+    /**
+     * @brief Remove every element.
+     */
+    void clear() {
+      parent_.clear();
+      size_.clear();
+      num_sets_ = 0;
+      largest_ = NO_ELEMENT;
+    }
+  private:
+    /**
+     * @brief Find the root of the set containing the passed element, pointing
+     * every other element on the way at its grandparent.
+     */
+    uint32_t findAndHalve(uint32_t x) {
+      while (parent_[x] != x) {
+        parent_[x] = parent_[parent_[x]];
+        x = parent_[x];
+      }
+      return x;
+    }
+
+    /**
+     * @brief The parent of every element, which is the element itself for
+     * the root of a set.
+     */
+    std::vector<uint32_t> parent_;
+
+    /**
+     * @brief The number of elements in the set of every root. Only the
+     * entries of roots are kept up to date.
+     */
+    std::vector<uint32_t> size_;
+
+    /**
+     * @brief The number of disjoint sets.
+     */
+    uint32_t num_sets_;
+
+    /**
+     * @brief The root of the largest set, or NO_ELEMENT.
+     */
+    uint32_t largest_;
+};
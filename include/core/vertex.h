@@ -1,6 +1,7 @@
 #pragma once
 #include <string>
 #include <vector>
+#include "address.h"
 #include "edge.h"
 
 /**
@@ -26,10 +27,12 @@ class Vertex {
      * @brief Construct a new Vertex object. By default Vertices are initialized 
      * with an empty list of indicent edges. 
      * 
-     * @param address a string indicating the address of the individual that 
+     * @param address an Address indicating the address of the individual that 
      * this Vertex represents. 
+     * @param id a uint32_t indicating the dense integer ID of this Vertex in 
+     * the graph that owns it.
      */
-    Vertex(const std::string& address);
+    Vertex(const Address& address, uint32_t id=0);
 
     /**
      * @brief Adds a new edge to the list of incident edges. Assumed to be used 
@@ -39,6 +42,14 @@ class Vertex {
      */
     void addEdge(Edge* e);
 
+    /**
+     * @brief Reserve space in the list of incident edges for the given number 
+     * of edges. Used when the degree of this vertex is known ahead of time.
+     * 
+     * @param count a size_t indicating the expected number of incident edges.
+     */
+    void reserveEdges(size_t count);
+
     /**
      * @brief Gets all incident edges to this vertex. Each indicent edge 
      * represents a transaction that the person represented by this Vertex was
@@ -50,12 +61,22 @@ class Vertex {
 
     /**
      * @brief Returns the blockchain address of the person represented by this 
-     * Vertex.
+     * Vertex. Use `Address::toHex` or the insertion operator to get the 
+     * hexadecimal form of the address.
      * 
-     * @return a const std::string& indicating the address of the person that 
+     * @return a const Address& indicating the address of the person that 
      * this Vertex represents.
      */
-    const std::string& getAddress() const;
+    const Address& getAddress() const;
+
+    /**
+     * @brief Returns the dense integer ID of this Vertex. Vertices are numbered
+     * 0, 1, 2, ... in the order they were added to the graph that owns them,
+     * so the ID can be used to index arrays of per-vertex data.
+     * 
+     * @return a uint32_t indicating the ID of this Vertex.
+     */
+    uint32_t getId() const { return id_; }
 
     /**
      * @brief Get whether or not this Vertex has been explored in some iteration 
@@ -118,70 +139,6 @@ class Vertex {
      */
     void setParent(Vertex* parent);
 
-    /**
-     * @brief Append a predecessor Vertex to the vector of Vertex* that stores 
-     * the parents of this vertex in any number of shortest paths. This vector 
-     * is used when computing betweenness centrality.
-     * 
-     * @param parent a Vertex* indicating the predecessor of this Vertex in some
-     * shortest path between 2 arbitrary vertices.
-     */
-    void addCentralityParent(Vertex* parent);
-
-    /**
-     * @brief Get all the Vertex* that precede this Vertex in any number of 
-     * shortest paths between two arbitrary vertices. This vector is used when 
-     * computing betweenness centrality.
-     * 
-     * @return a const std::vector<Vertex*>& containing pointers to predecessor
-     * vertices filled after computing shortest paths between some arbitrary 
-     * vertex and all other vertices in the graph. 
-     */
-    const std::vector<Vertex*>& getCentralityParents() const;
-
-    /**
-     * @brief Increment the centrality score used when computing betweenness 
-     * centrality by some amount. This value represents the number of shortest 
-     * paths between 2 other arbitrary vertices that this vertex appears in.
-     * 
-     * @param amount a double indicating the number of shortest paths between 2 
-     * other arbitrary vertices that this vertex appears in.
-     */
-    void incrementCentrality(double amount);
-
-    /**
-     * @brief Get the centrality score used when computing betweenness 
-     * centrality. This value represents the number of shortest paths between 2 
-     * other arbitrary vertices that this vertex appears in.
-     * 
-     * @return a double indicating the number of shortest paths between 2 
-     * other arbitrary vertices that this vertex appears in.
-     */
-    double getCentrality() const;
-
-    /**
-     * @brief Increment the dependency score of this vertex. This dependency 
-     * metric is used when computing betweenness centrality to represent the 
-     * ratio of shortest paths between 2 other arbitrary vertices that this 
-     * vertex lies on.
-     * 
-     * @param amount a double indicating the ratio of shortest paths between 2 
-     * other arbitrary vertices that this vertex lies on with which to increment
-     * this node's dependency score.
-     */
-    void incrementDependency(double amount);
-
-    /**
-     * @brief Get the dependency score of this vertex. This dependency metric is 
-     * used when computing betweenness centrality to represent the ratio of 
-     * shortest paths between 2 other arbitrary vertices that this vertex lies 
-     * on.
-     * 
-     * @return a double indicating the ratio of shortest paths between 2 other 
-     * arbitrary vertices that this vertex lies on.
-     */
-    double getDependency() const;
-
     /**
      * @brief Reset all internal state that is accessed and updated when running
      * various graph algorithms. This function is meant to be used at the start 
@@ -195,7 +152,12 @@ class Vertex {
      * @brief The blockchain address of the person represented by this 
      * Vertex.
      */
-    std::string address_;
+    Address address_;
+
+    /**
+     * @brief The dense integer ID of this Vertex in the graph that owns it.
+     */
+    uint32_t id_;
 
     /**
      * @brief All of the edges that are indicident to this Vertex. Each indicent 
@@ -223,47 +185,4 @@ class Vertex {
      * to all other vertices. 
      */
     Vertex* parent_;
-
-    /**
-     * @brief A vector of Vertex* that stores the parents of this vertex in any
-     * number of shortest paths. This vector is used when computing betweenness
-     * centrality.
-     */
-    std::vector<Vertex*> centrality_parents_;
-
-    /**
-     * @brief A double used when computing betweenness centrality. This value 
-     * represents the number of shortest paths between 2 other arbitrary 
-     * vertices that this vertex appears in.
-     */
-    double centrality_;
-
-    /**
-     * @brief A double used when computing betweenness centrality. This value 
-     * represents the ratio of shortest paths between 2 other 
-     * arbitrary vertices that this vertex lies on.
-     */
-    double dependency_;
-};
-
-/**
- * @brief This comparator is used to compare the distance values of two Vertex*. 
- * This comparator struct is used to construct a priority queue of Vertex* in
- * our implementation of Dijkstra's algorithm. 
- */
-struct VertexPointerComparator {
-  /**
-   * @brief Compares the distance parameters of two Vertex objects. This
-   * operator is used by the priority queue in the implementation of
-   * Dijkstra's algorithm to find the shortest path between two vertices.
-   *
-   * @param arg1 one of the Vertex objects with which to compare distances with.
-   * @param arg2 the other Vertex object with which to compare distances with.
-   *
-   * @return true if arg1 has a larger distance than arg2.
-   * @return false if arg1 has a smaller distance than arg2.
-   */
-  bool operator() (Vertex* arg1, Vertex* arg2) {
-    return (arg1->getDistance() > arg2->getDistance());
-  }
 };
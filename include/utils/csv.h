@@ -0,0 +1,65 @@
+#pragma once
+#include <string_view>
+#include <cstdint>
+
+/**
+ * @brief A single etherium transaction parsed from one record of a CSV file.
+ * The address fields are views into the buffer the record was parsed from, so
+ * a TransactionRecord is only valid for as long as that buffer is alive. No
+ * memory is allocated when parsing a record.
+ */
+struct TransactionRecord {
+  /**
+   * @brief A view of the blockchain address that sent the transaction.
+   */
+  std::string_view from_address;
+
+  /**
+   * @brief A view of the blockchain address that received the transaction.
+   */
+  std::string_view to_address;
+
+  /**
+   * @brief The value exchanged in the transaction in the trillions (multiply
+   * by 10^12 to get the actual value).
+   */
+  double value;
+
+  /**
+   * @brief The gas used in the transaction.
+   */
+  uint64_t gas;
+
+  /**
+   * @brief The price of gas at the time of the transaction.
+   */
+  uint64_t gas_price;
+};
+
+/**
+ * @brief Split the next line off of the front of the passed buffer. The
+ * returned line excludes the line terminator (either "\n" or "\r\n"), and the
+ * passed buffer is advanced past the terminator.
+ *
+ * @param buffer a std::string_view of the remaining unparsed input. This view
+ * is shrunk to begin at the start of the following line.
+ * @return a std::string_view of the next line in the buffer.
+ */
+std::string_view next_line(std::string_view& buffer);
+
+/**
+ * @brief Tokenize a single CSV record in place. Records are formatted as
+ * follows:
+ *
+ * idx,from_address,to_address,truncated_value,gas,gas_price
+ *
+ * @param line a std::string_view of a single CSV record without its line
+ * terminator.
+ * @param record a TransactionRecord to fill with the parsed fields. The
+ * address fields of the record point into the passed line.
+ * @return true if the record contained every field and each numeric field was
+ * a valid number.
+ * @return false if the record was malformed, in which case the contents of the
+ * passed record are unspecified.
+ */
+bool parse_transaction(std::string_view line, TransactionRecord& record);
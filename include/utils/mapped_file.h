@@ -0,0 +1,84 @@
+#pragma once
+#include <string_view>
+#include <string>
+
+/**
+ * @brief A read-only view of a file on disk that is mapped directly into this
+ * process' address space using mmap. The contents of the file can be read in
+ * place through `data` without copying them into a separate buffer, which makes
+ * this class suitable for tokenizing large CSV files without allocating a
+ * string per line. The mapping is released when the MappedFile is destroyed,
+ * so views into the file must not outlive the MappedFile they came from.
+ */
+class MappedFile {
+  public:
+    /**
+     * @brief Map the file at the given path into memory. If the file cannot be
+     * opened or mapped, the MappedFile is left in a closed state which can be
+     * checked using `isOpen`.
+     *
+     * @param path a string indicating the path to the file to map.
+     */
+    MappedFile(const std::string& path);
+
+    /**
+     * @brief Destroy the MappedFile object by unmapping the file from memory.
+     */
+    ~MappedFile();
+
+    /**
+     * @brief A MappedFile owns its mapping, so it cannot be copied.
+     */
+    MappedFile(const MappedFile& other) = delete;
+
+    /**
+     * @brief A MappedFile owns its mapping, so it cannot be assigned to.
+     */
+    MappedFile& operator=(const MappedFile& rhs) = delete;
+
+    /**
+     * @brief Check whether the file was successfully opened and mapped.
+     *
+     * @return true if the file was opened and mapped into memory.
+     * @return false if the file could not be opened or mapped.
+     */
+    bool isOpen() const { return open_; }
+
+    /**
+     * @brief Get a pointer to the first byte of the mapped file.
+     *
+     * @return a const char* pointing to the start of the file contents, or NULL
+     * if the file is empty or could not be mapped.
+     */
+    const char* data() const { return data_; }
+
+    /**
+     * @brief Get the size of the mapped file in bytes.
+     *
+     * @return a size_t indicating the number of bytes in the mapped file.
+     */
+    size_t size() const { return size_; }
+
+    /**
+     * @brief Get a view of the entire contents of the mapped file.
+     *
+     * @return a std::string_view spanning every byte of the mapped file.
+     */
+    std::string_view contents() const { return std::string_view(data_, size_); }
+  private:
+    /**
+     * @brief A pointer to the start of the mapped region, or NULL if nothing
+     * is mapped.
+     */
+    const char* data_;
+
+    /**
+     * @brief The number of bytes in the mapped region.
+     */
+    size_t size_;
+
+    /**
+     * @brief Whether or not the file was successfully opened and mapped.
+     */
+    bool open_;
+};
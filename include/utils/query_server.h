@@ -0,0 +1,212 @@
+#pragma once
+#include <condition_variable>
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
+#include <deque>
+#include <mutex>
+
+#include "algorithms/workspace.h"
+#include "core/csr_graph.h"
+#include "core/graph.h"
+
+/**
+ * @brief A server that answers queries about a loaded graph over a Unix domain
+ * socket, so that tools can query the graph without loading it themselves.
+ *
+ * Clients send one request per line and receive one line in response, which
+ * starts with "OK" followed by the result, or "ERR" followed by a message:
+ *
+ *   PING                     OK pong
+ *   BFS <address>            OK <vertices reached> <largest hop distance>
+ *   COMPONENT <address>      OK <component> <vertices in the component>
+ *   DIST <source> <target>   OK <gas distance>, or OK unreachable
+ *   PATH <source> <target>   OK <gas distance> <address> ... <address>
+ *   CENTRALITY <address>     OK <betweenness centrality>
+ *   QUIT                     closes the connection
+ *   SHUTDOWN                 OK shutting down, then stops the server
+ *
+ * A single thread polls the socket and every connection, and hands each
+ * complete request line to a fixed number of worker threads that answer it
+ * with their own traversal workspaces. Workers are only busy while answering,
+ * so idle connections never keep other clients waiting. Each connection has at
+ * most one request being answered at a time, so responses are sent in the
+ * order requests were. The graph is never modified after the server starts,
+ * so requests never wait on each other.
+ */
+class QueryServer {
+  public:
+    /**
+     * @brief Construct a server for the passed graph. Connected components are
+     * labeled up front so that component requests take constant time.
+     *
+     * @param g a Graph to look up addresses in, which must outlive the server.
+     * @param csr the CSRGraph of g to answer queries on, which must outlive
+     * the server.
+     * @param centrality the betweenness centrality of every vertex indexed by
+     * vertex ID, or an empty vector if it was not computed, in which case
+     * centrality requests fail.
+     * @param num_workers an int indicating the number of requests that can be
+     * answered at once.
+     */
+    QueryServer(const Graph& g, const CSRGraph& csr,
+                std::vector<double> centrality, int num_workers=1);
+
+    /**
+     * @brief Close the socket if it is still open.
+     */
+    ~QueryServer();
+
+    /**
+     * @brief A QueryServer owns its socket, so it cannot be copied.
+     */
+    QueryServer(const QueryServer& other) = delete;
+
+    /**
+     * @brief A QueryServer owns its socket, so it cannot be assigned to.
+     */
+    QueryServer& operator=(const QueryServer& rhs) = delete;
+
+    /**
+     * @brief Create a Unix domain socket at the passed path and start
+     * listening on it. A stale socket file left at the path is replaced,
+     * but any other file at the path is left alone.
+     *
+     * @param path a std::string indicating the path of the socket.
+     * @return true if the server is listening on the socket.
+     * @return false if the socket could not be created or the path holds a
+     * file that is not a socket.
+     */
+    bool listen(const std::string& path);
+
+    /**
+     * @brief Answer requests until `stop` is called or a client sends
+     * SHUTDOWN. `listen` must have succeeded first. The socket file is removed
+     * before returning.
+     */
+    void serve();
+
+    /**
+     * @brief Make `serve` return once the requests being answered finish. May
+     * be called from any thread.
+     */
+    void stop() { stopping_ = true; }
+
+    /**
+     * @brief Answer a single request line as a client would see it, without
+     * the trailing newline.
+     *
+     * @param request a std::string holding one request line.
+     * @return a std::string holding the response line.
+     */
+    std::string answer(const std::string& request);
+  private:
+    /**
+     * @brief The traversal workspaces owned by a single worker thread.
+     */
+    struct Workspaces {
+      explicit Workspaces(const CSRGraph& g) : forward(g), backward(g) { }
+
+      TraversalWorkspace forward;
+      TraversalWorkspace backward;
+    };
+
+    /**
+     * @brief A request line read from a connection, and once a worker has
+     * answered it, the response line.
+     */
+    struct Job {
+      int fd;
+      std::string request;
+      std::string response;
+    };
+
+    /**
+     * @brief Answer the jobs handed out by `serve` until `serve` is done.
+     */
+    void workerLoop();
+
+    /**
+     * @brief Answer a single request with the passed workspaces.
+     */
+    std::string answer(const std::string& request, Workspaces& workspaces);
+
+    /**
+     * @brief The graph addresses are looked up in.
+     */
+    const Graph& graph_;
+
+    /**
+     * @brief The graph queries are answered on.
+     */
+    const CSRGraph& csr_;
+
+    /**
+     * @brief The betweenness centrality of every vertex, or empty.
+     */
+    std::vector<double> centrality_;
+
+    /**
+     * @brief The connected component of every vertex.
+     */
+    std::vector<uint32_t> components_;
+
+    /**
+     * @brief The number of vertices in each connected component.
+     */
+    std::vector<uint32_t> component_sizes_;
+
+    /**
+     * @brief The number of worker threads started by `serve`.
+     */
+    int num_workers_;
+
+    /**
+     * @brief The listening socket, or -1.
+     */
+    int listen_fd_;
+
+    /**
+     * @brief The path of the socket file.
+     */
+    std::string path_;
+
+    /**
+     * @brief Set once the server should stop. `serve` stops accepting
+     * connections and reading requests once it is set.
+     */
+    std::atomic<bool> stopping_;
+
+    /**
+     * @brief Guards pending_, finished_, and done_.
+     */
+    std::mutex mutex_;
+
+    /**
+     * @brief Signaled when a job is pending or the workers should exit.
+     */
+    std::condition_variable ready_;
+
+    /**
+     * @brief Jobs waiting for a worker.
+     */
+    std::deque<Job> pending_;
+
+    /**
+     * @brief Jobs answered by a worker whose responses `serve` has not taken.
+     */
+    std::vector<Job> finished_;
+
+    /**
+     * @brief Set once `serve` returns, so that idle workers exit.
+     */
+    bool done_;
+
+    /**
+     * @brief The write end of a pipe that workers write to after finishing a
+     * job, waking `serve` from poll.
+     */
+    int wake_fd_;
+};
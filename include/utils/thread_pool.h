@@ -0,0 +1,141 @@
+#pragma once
+#include <condition_variable>
+#include <functional>
+#include <cstddef>
+#include <thread>
+#include <atomic>
+#include <vector>
+#include <mutex>
+
+/**
+ * @brief A fixed group of threads that run parallel loops. The threads are
+ * started once and sleep between loops, so algorithms that run many short
+ * parallel phases, such as delta-stepping, do not pay to start a thread per
+ * phase.
+ *
+ * The thread that calls `parallelFor` takes part in the loop as thread 0, so a
+ * pool of size 1 starts no threads at all and runs every loop inline.
+ */
+class ThreadPool {
+  public:
+    /**
+     * @brief Start a pool that runs loops on num_threads threads, counting the
+     * calling thread.
+     *
+     * @param num_threads an int indicating the number of threads. Values less
+     * than or equal to 1 run every loop on the calling thread.
+     */
+    explicit ThreadPool(int num_threads);
+
+    /**
+     * @brief Wake every thread of the pool, let it exit, and join it.
+     */
+    ~ThreadPool();
+
+    /**
+     * @brief A ThreadPool owns its threads, so it cannot be copied.
+     */
+    ThreadPool(const ThreadPool& other) = delete;
+
+    /**
+     * @brief A ThreadPool owns its threads, so it cannot be assigned to.
+     */
+    ThreadPool& operator=(const ThreadPool& rhs) = delete;
+
+    /**
+     * @brief Get the number of threads loops run on, counting the calling
+     * thread.
+     *
+     * @return an int indicating the number of threads.
+     */
+    int size() const { return workers_.size() + 1; }
+
+    /**
+     * @brief Run task(i, thread) for every i in [0, num_tasks) and return once
+     * every call has finished. Tasks are handed out one at a time to whichever
+     * thread is free, so tasks of uneven cost are balanced between threads. 
+     * The thread argument is in [0, size()) and identifies the thread running 
+     * the task, so tasks can write to per-thread buffers without locking.
+     *
+     * @param num_tasks a size_t indicating the number of tasks to run.
+     * @param task the function to call for each task.
+     */
+    void parallelFor(size_t num_tasks, 
+                     const std::function<void(size_t, int)>& task);
+
+    /**
+     * @brief Split [0, n) into consecutive blocks of the passed size and run
+     * fn(begin, end, thread) once for every block [begin, end), in parallel.
+     * Blocks are handed out like the tasks of `parallelFor`, so a block only
+     * needs to hold enough work to amortize handing it out; the last block
+     * may be shorter than the rest.
+     *
+     * @param n a size_t indicating the number of items to split.
+     * @param block a size_t indicating the number of items in each block.
+     * @param fn the function to call for each block.
+     */
+    void parallelForRange(size_t n, size_t block,
+        const std::function<void(size_t, size_t, int)>& fn);
+  private:
+    /**
+     * @brief The loop run by each thread of the pool: wait for a new 
+     * parallelFor call, take part in it, and report back when done.
+     */
+    void workerLoop(int thread_index);
+
+    /**
+     * @brief Take tasks of the current loop until none are left.
+     */
+    void runTasks(int thread_index);
+
+    /**
+     * @brief The threads started by this pool, which excludes the caller.
+     */
+    std::vector<std::thread> workers_;
+
+    /**
+     * @brief Guards every field below except next_task_.
+     */
+    std::mutex mutex_;
+
+    /**
+     * @brief Signals workers that a new loop started or the pool is stopping.
+     */
+    std::condition_variable start_;
+
+    /**
+     * @brief Signals the caller of parallelFor that a worker finished.
+     */
+    std::condition_variable done_;
+
+    /**
+     * @brief The task of the current loop.
+     */
+    const std::function<void(size_t, int)>* task_;
+
+    /**
+     * @brief The number of tasks in the current loop.
+     */
+    size_t num_tasks_;
+
+    /**
+     * @brief The index of the next task to hand out in the current loop.
+     */
+    std::atomic<size_t> next_task_;
+
+    /**
+     * @brief Incremented each time a loop starts, so that workers can tell a
+     * new loop from a spurious wake up.
+     */
+    size_t generation_;
+
+    /**
+     * @brief The number of workers still running tasks of the current loop.
+     */
+    int busy_workers_;
+
+    /**
+     * @brief Whether the pool is being destroyed.
+     */
+    bool stopping_;
+};
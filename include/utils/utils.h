@@ -3,6 +3,8 @@
 #include <string>
 #include <ctime>
 
+#include "core/address.h"
+
 // Constants used to print in color to the command line
 // Taken from https://stackoverflow.com/a/9158263
 #define RESET       "\033[0m"
@@ -34,19 +36,42 @@
  */
 void print_elapsed(clock_t& c1, clock_t& c2, const std::string_view& action);
 
+/**
+ * @brief Prints the given wall clock time in seconds along with the name of 
+ * the associated action. Used for work spread across several threads, whose
+ * CPU time overstates how long the user waited.
+ * 
+ * @param seconds a double indicating the wall clock time taken in seconds.
+ * @param action a string indicating the name of the associated action.
+ */
+void print_wall_elapsed(double seconds, const std::string_view& action);
+
+/**
+ * @brief Computes the rate at which the given number of bytes were processed 
+ * in the given number of seconds and prints the throughput in MB/s along with
+ * the name of the associated action.
+ * 
+ * @param bytes a size_t indicating the number of bytes processed.
+ * @param seconds a double indicating the wall clock time taken in seconds.
+ * @param action a string indicating the name of the associated action.
+ */
+void print_throughput(size_t bytes, double seconds, 
+                      const std::string_view& action);
+
 /**
  * @brief Compare two pairs representing betweenness centrality scores for two
- * different vertices denoted by the string indicating the vertex address in the
+ * different vertices denoted by the Address of the vertex in the
  * blockchain and the betweenness centrality score of the address in the 
  * network. This function is used to sort an unordered map of betweenness 
  * centrality scores using a vector.
  * 
- * @param p1 one of the pairs composed of a string and a double used to compare.
- * @param p2 another pair composed of a string and a double used to compare.
+ * @param p1 one of the pairs composed of an Address and a double used to 
+ * compare.
+ * @param p2 another pair composed of an Address and a double used to compare.
  * @return true if the betweenness centrality score of the first pair is larger
  * than the betweenness centrality score of the second pair.
  * @return false if the betweenness centrality score of the first pair is 
  * smaller than the betweenness centrality score of the second pair.
  */
-bool compare_bc_pair(const std::pair<std::string, double>& p1,
-                     const std::pair<std::string, double>& p2);
+bool compare_bc_pair(const std::pair<Address, double>& p1,
+                     const std::pair<Address, double>& p2);
@@ -0,0 +1,229 @@
+#include "algorithms/batch_queries.h"
+#include "algorithms/shortest_path.h"
+#include "utils/thread_pool.h"
+
+#include <condition_variable>
+#include <algorithm>
+#include <stdexcept>
+#include <sstream>
+#include <memory>
+#include <mutex>
+
+using std::condition_variable;
+using std::istringstream;
+using std::unique_lock;
+using std::unique_ptr;
+using std::istream;
+using std::ostream;
+using std::string;
+using std::vector;
+using std::mutex;
+
+/**
+ * @brief The number of queries per thread that may be answered ahead of the
+ * oldest query whose results are not yet written. A larger window lets
+ * threads keep working past a slow query, a smaller one holds fewer results.
+ */
+static const size_t QUERIES_PER_THREAD = 16;
+
+/**
+ * @brief The number of bytes of results that may wait to be written before
+ * threads stop starting queries ahead of the oldest unwritten one.
+ */
+static const size_t MAX_BUFFERED_BYTES = 64 << 20;
+
+void parse_batch_queries(istream& in, const Graph& g, 
+                         vector<BatchQuery>& queries, vector<string>& errors) {
+  string line;
+  size_t number = 0;
+
+  while (std::getline(in, line)) {
+    ++number;
+    if (!line.empty() && line.back() == '\r') line.pop_back();
+
+    istringstream fields(line);
+    string type, first, second, extra;
+    fields >> type >> first >> second >> extra;
+
+    if (type.empty() || type[0] == '#') continue;
+
+    auto error = [&](const string& message) {
+      errors.push_back("line " + std::to_string(number) + ": " + message);
+    };
+
+    BatchQuery query = {BatchQuery::Type::DISTANCE, number, 0, 0, 0};
+    size_t num_fields;
+
+    if (type == "dist") {
+      query.type = BatchQuery::Type::DISTANCE;
+      num_fields = 2;
+    } else if (type == "knn") {
+      query.type = BatchQuery::Type::NEAREST;
+      num_fields = 2;
+    } else if (type == "sssp") {
+      query.type = BatchQuery::Type::SINGLE_SOURCE;
+      num_fields = 1;
+    } else {
+      error("unknown query type " + type);
+      continue;
+    }
+
+    bool has_second = !second.empty();
+    if (first.empty() || has_second != (num_fields == 2) || !extra.empty()) {
+      error("expected " + std::to_string(num_fields) + " arguments to " + 
+            type);
+      continue;
+    }
+
+    Vertex* source = g.getVertex(first);
+    if (source == NULL) {
+      error("could not find vertex with address " + first);
+      continue;
+    }
+    query.source = source->getId();
+
+    if (query.type == BatchQuery::Type::DISTANCE) {
+      Vertex* target = g.getVertex(second);
+      if (target == NULL) {
+        error("could not find vertex with address " + second);
+        continue;
+      }
+      query.target = target->getId();
+    } else if (query.type == BatchQuery::Type::NEAREST) {
+      try {
+        size_t end;
+        long k = std::stol(second, &end);
+        if (end != second.size() || k < 0 || k >= 0xFFFFFFFF) {
+          throw std::invalid_argument(second);
+        }
+        query.k = k;
+      } catch (const std::logic_error& e) {
+        error("expected a number of vertices, got " + second);
+        continue;
+      }
+    }
+
+    queries.push_back(query);
+  }
+}
+
+namespace {
+
+/**
+ * @brief The traversal workspaces owned by a single thread answering queries.
+ */
+struct QueryWorkspaces {
+  explicit QueryWorkspaces(const CSRGraph& g) : forward(g), backward(g) { }
+
+  TraversalWorkspace forward;
+  TraversalWorkspace backward;
+};
+
+} // namespace
+
+/**
+ * @brief Append one CSV row of output for a query to the passed string.
+ */
+static void append_row(string& out, const BatchQuery& query,
+                       const Address& address, uint64_t distance) {
+  out += std::to_string(query.line);
+  out += ',';
+  out += address.toHex();
+  out += ',';
+  out += distance == TraversalWorkspace::UNREACHED
+    ? string(UNREACHABLE_DISTANCE) : std::to_string(distance);
+  out += '\n';
+}
+
+/**
+ * @brief Answer a single query and append its rows of output to the passed
+ * string.
+ */
+static void answer_query(const CSRGraph& g, const BatchQuery& query,
+                         QueryWorkspaces& workspaces, QueueType queue,
+                         string& out) {
+  if (query.type == BatchQuery::Type::DISTANCE) {
+    ShortestPath result = shortest_path(g, query.source, query.target, 
+                                        workspaces.forward, 
+                                        workspaces.backward);
+    append_row(out, query, g.getAddress(query.target), result.distance);
+    return;
+  }
+
+  TraversalWorkspace& workspace = workspaces.forward;
+
+  if (query.type == BatchQuery::Type::NEAREST) {
+    // the source itself is settled first but is not one of its neighbors
+    SearchLimits limits;
+    limits.max_settled = query.k + 1;
+    bounded_dijkstra(g, query.source, workspace, limits, queue);
+  } else {
+    dijkstra(g, query.source, workspace, queue);
+  }
+
+  for (uint32_t v : workspace.getSettledOrder()) {
+    if (query.type == BatchQuery::Type::NEAREST && v == query.source) continue;
+    append_row(out, query, g.getAddress(v), workspace.getDistance(v));
+  }
+}
+
+void run_batch_queries(const CSRGraph& g, const vector<BatchQuery>& queries,
+                       ostream& out, int num_threads, QueueType queue) {
+  ThreadPool pool(std::max(num_threads, 1));
+  vector<unique_ptr<QueryWorkspaces>> workspaces(pool.size());
+
+  // results wait in a ring of slots, indexed by query modulo the window,
+  // until every earlier query has been written
+  size_t window = pool.size() * QUERIES_PER_THREAD;
+  vector<string> results(window);
+  vector<bool> answered(window, false);
+  size_t next_to_write = 0, buffered_bytes = 0;
+  mutex lock_results;
+  condition_variable written;
+
+  out << "query,address,distance\n";
+
+  // queries are handed out in order, so the oldest unwritten query is always
+  // being answered and threads waiting on it never wait forever
+  pool.parallelFor(queries.size(), [&](size_t i, int thread) {
+    {
+      unique_lock<mutex> lock(lock_results);
+      written.wait(lock, [&]() {
+        return i == next_to_write || (i < next_to_write + window 
+                                      && buffered_bytes < MAX_BUFFERED_BYTES);
+      });
+    }
+
+    if (!workspaces[thread]) {
+      workspaces[thread].reset(new QueryWorkspaces(g));
+    }
+
+    string result;
+    answer_query(g, queries[i], *workspaces[thread], queue, result);
+
+    unique_lock<mutex> lock(lock_results);
+    buffered_bytes += result.size();
+    results[i % window].swap(result);
+    answered[i % window] = true;
+
+    // the thread that answers the oldest unwritten query writes it and every
+    // answered query after it, outside the lock so others keep storing
+    if (i != next_to_write) return;
+
+    while (answered[next_to_write % window]) {
+      string ready;
+      ready.swap(results[next_to_write % window]);
+      answered[next_to_write % window] = false;
+
+      lock.unlock();
+      out << ready;
+      lock.lock();
+
+      buffered_bytes -= ready.size();
+      ++next_to_write;
+      written.notify_all();
+    }
+  });
+
+  out.flush();
+}
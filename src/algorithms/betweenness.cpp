@@ -1,158 +1,201 @@
 #include "algorithms/betweenness.h"
 #include "algorithms/dijkstras.h"
 #include "utils/utils.h"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <thread>
 #include <vector>
 
-using std::unordered_map;
-using std::make_pair;
-using std::advance;
-using std::promise;
-using std::future;
+using std::chrono::steady_clock;
+using std::chrono::duration;
 using std::vector;
-using std::string;
 using std::thread;
-using std::pair;
+using std::atomic;
 using std::move;
 
-std::unordered_map<std::string, double> compute_betweenness_centrality(
+CentralityMap compute_betweenness_centrality(
     Graph* graph, int num_threads, bool verbose) {
-  if (num_threads <= 1) {
-    return compute_betweenness_centrality_sequential(graph);
-  } else {
-    return compute_betweenness_centrality_parallel(graph, num_threads, verbose);
-  }
-}
+  // Every thread shares one read-only compressed copy of the graph
+  CSRGraph csr(*graph);
+  vector<double> scores = 
+    compute_betweenness_centrality(csr, num_threads, verbose);
 
-unordered_map<string, double> compute_betweenness_centrality_sequential(Graph* graph) {
-  unordered_map<string, double> betweenness_centrality;
+  CentralityMap betweenness_centrality;
+  betweenness_centrality.reserve(scores.size());
 
-  for (pair<string, Vertex*> vertexPair : graph->getVertices()) {
-    betweenness_centrality.insert({vertexPair.second->getAddress(), 0.0});
+  for (uint32_t id = 0; id < scores.size(); ++id) {
+    betweenness_centrality.insert({csr.getAddress(id), scores[id]});
   }
-  
-  for (pair<string, Vertex*> vertexPair : graph->getVertices()) {
-    // single-shortest-path
-    dijkstra(graph, vertexPair.second);
 
-    // accumulation
-    while (graph->hasDistanceOrderedVertices()) {
-      Vertex* w = graph->popDistanceOrderedVertex();
-
-      for (Vertex* v : w->getCentralityParents()) {
-        if (w->getCentrality() == 0) continue;
+  return betweenness_centrality;
+}
 
-        v->incrementDependency((v->getCentrality() / w->getCentrality()) * (1 + w->getDependency()));
-      }
+/**
+ * @brief Run Dijkstra's algorithm from the passed source and accumulate the 
+ * dependency of the source on every other vertex into the passed scores. 
+ * Vertices are visited in the reverse of the order they were settled in, so 
+ * each vertex is visited after every vertex it precedes on a shortest path.
+ *
+ * @param graph the CSRGraph being searched.
+ * @param source the ID of the vertex to search from.
+ * @param workspace the TraversalWorkspace to search with.
+ * @param betweenness_centrality the scores to accumulate into.
+ * @param queue the priority queue Dijkstra's algorithm uses.
+ * @return the number of shortest paths from the source to every other vertex
+ * it reaches.
+ */
+static double accumulate_dependencies(const CSRGraph& graph, uint32_t source,
+                                      TraversalWorkspace& workspace,
+                                      vector<double>& betweenness_centrality,
+                                      QueueType queue) {
+  // single-shortest-path
+  dijkstra(graph, source, workspace, queue);
+
+  // accumulation
+  const vector<uint32_t>& order = workspace.getSettledOrder();
+  double num_paths = 0.0;
+  for (auto it = order.rbegin(); it != order.rend(); ++it) {
+    uint32_t w = *it;
+
+    for (const uint32_t* v = workspace.predecessorsBegin(w); 
+         v != workspace.predecessorsEnd(w); ++v) {
+      workspace.incrementDependency(*v, 
+        (workspace.getPathCount(*v) / workspace.getPathCount(w)) 
+        * (1 + workspace.getDependency(w)));
+    }
 
-      // only add centrality to paths that do not start/end at the starting vertex
-      if (w != vertexPair.second) {
-        // divide by because its an undirected graph so each edge is counted
-        // twice (since algo is for directed graphs)
-        betweenness_centrality[w->getAddress()] += w->getDependency() / 2.0;
-      }
+    // only add centrality to paths that do not start/end at the starting vertex
+    if (w != source) {
+      // divide by because its an undirected graph so each edge is counted
+      // twice (since algo is for directed graphs)
+      betweenness_centrality[w] += workspace.getDependency(w) / 2.0;
+      num_paths += workspace.getPathCount(w);
     }
   }
 
-  return betweenness_centrality;
+  return num_paths;
 }
 
-unordered_map<string, double> compute_betweenness_centrality_parallel(
-    Graph* graph, int num_threads, bool verbose) {
-  vector<pair<thread, future<unordered_map<string, double>>>> thread_group;
-
-  for (int thread_idx = 0; thread_idx < num_threads; ++thread_idx) {
-    Graph* copied_graph = new Graph(*graph);
-    promise<unordered_map<string, double>> thread_result;
-    auto completable_future = thread_result.get_future();
-
-
-    thread next_thread(&compute_betweenness_centrality_parallel_helper,
-                       std::move(thread_result), copied_graph,
-                       thread_idx, num_threads, verbose);
-
-    thread_group.emplace_back(move(next_thread), move(completable_future));
-  }
-
-  unordered_map<string, double> betweenness_centrality;
+/**
+ * @brief How long a chunk of sources should take to search, in seconds. Chunks
+ * are sized from the observed cost of a source so that taking a chunk off the
+ * shared counter is rare compared to the searches themselves.
+ */
+static const double SECONDS_PER_CHUNK = 0.01;
+
+/**
+ * @brief The number of chunks each thread should still get from the sources
+ * that are left. Capping chunks to a share of the remaining sources shrinks
+ * them towards the end of the run, so no thread is left with a large chunk
+ * while the others are idle.
+ */
+static const uint32_t CHUNKS_PER_THREAD = 4;
+
+/**
+ * @brief The weight of the latest chunk in the running average cost of a
+ * source.
+ */
+static const double COST_SMOOTHING = 0.5;
+
+/**
+ * @brief Accumulate the dependencies of the sources this thread takes off the
+ * shared counter into the passed scores. Sources are taken in chunks of
+ * consecutive IDs, sized so that a chunk takes about SECONDS_PER_CHUNK given
+ * the average cost of the sources this thread has searched so far, but never
+ * larger than an even share of the sources that are left. The shortest paths
+ * from every source are counted into num_paths.
+ */
+static void compute_betweenness_centrality_csr_helper(
+    const CSRGraph* graph, vector<double>* betweenness_centrality,
+    double* num_paths, atomic<uint32_t>* next_source, int thread_index,
+    int num_threads, bool verbose, QueueType queue) {
+  TraversalWorkspace workspace(*graph);
+  uint32_t n = graph->numVertices();
+  uint64_t iteration = 0;
+
+  // seconds per source, or 0 until the first chunk has been timed
+  double cost = 0.0;
+
+  while (true) {
+    uint32_t remaining = n - std::min(n, next_source->load());
+    uint32_t share = remaining / (CHUNKS_PER_THREAD * num_threads);
+    uint32_t chunk = 1;
+
+    if (cost > 0.0) {
+      chunk = std::min<double>(SECONDS_PER_CHUNK / cost, share);
+    }
+    chunk = std::max<uint32_t>(chunk, 1);
 
-  // Go through each thread, get the resulting confusion matrix, and aggregate
-  for (pair<thread, future<unordered_map<string, double>>>& t : thread_group) {
-    // Adapted from https://stackoverflow.com/a/57134334
-    thread next_thread = std::move(t.first);
-    future<unordered_map<string, double>> result = std::move(t.second);
+    uint32_t first = next_source->fetch_add(chunk);
+    if (first >= n) break;
+    uint32_t last = std::min<uint64_t>(n, uint64_t(first) + chunk);
 
-    // retrieve result from promise
-    unordered_map<string, double> partial_centrality = result.get();
+    auto chunk_start = steady_clock::now();
+    for (uint32_t source = first; source < last; ++source) {
+      if (verbose && iteration % 100 == 0) {
+        std::cout << YELLOW << "Thread " << thread_index << " at iteration "
+                  << iteration << "." << RESET << std::endl;
+      }
 
-    // Aggregate the results
-    for (pair<string, double> p : partial_centrality) {
-      betweenness_centrality[p.first] += p.second;
+      *num_paths += accumulate_dependencies(*graph, source, workspace,
+                                            *betweenness_centrality, queue);
+      ++iteration;
     }
-
-    next_thread.join(); // Close the thread
+    duration<double> elapsed = steady_clock::now() - chunk_start;
+
+    double chunk_cost = elapsed.count() / (last - first);
+    cost = cost > 0.0
+      ? COST_SMOOTHING * chunk_cost + (1 - COST_SMOOTHING) * cost
+      : chunk_cost;
+    // a chunk too quick for the clock would otherwise keep chunks at 1
+    cost = std::max(cost, 1e-9);
   }
-
-  return betweenness_centrality;
 }
 
-void compute_betweenness_centrality_parallel_helper(
-    std::promise<std::unordered_map<std::string, double>> thread_result,
-    Graph* graph, int thread_index, int num_threads, bool verbose) {
-  unordered_map<string, double> betweenness_centrality;
-
-  for (pair<string, Vertex*> vertexPair : graph->getVertices()) {
-    betweenness_centrality.insert({vertexPair.second->getAddress(), 0.0});
-  }
-
-  auto it = graph->getVertices().begin();
-  auto end = graph->getVertices().end();
+vector<double> compute_betweenness_centrality(
+    const CSRGraph& graph, int num_threads, bool verbose, QueueType queue,
+    double* num_shortest_paths) {
+  num_threads = std::max(num_threads, 1);
 
-  // increment the iterator to start at the offset this thread operates on
-  int counter = 0;
-  while (it != end && counter < thread_index) {
-    ++it;
-    ++counter;
-  }
+  vector<vector<double>> partial_centrality(
+    num_threads, vector<double>(graph.numVertices(), 0.0)
+  );
+  vector<double> partial_paths(num_threads, 0.0);
 
-  int iteration = -1;
+  // the next source no thread has taken yet
+  atomic<uint32_t> next_source(0);
 
-  while (it != end) {
-    if (verbose && ++iteration % 100 == 0) {
-      std::cout << YELLOW << "Thread " << thread_index << " at iteration "
-                << iteration << "." << RESET << std::endl;
+  if (num_threads == 1) {
+    compute_betweenness_centrality_csr_helper(
+      &graph, &partial_centrality[0], &partial_paths[0], &next_source, 0, 1,
+      verbose, queue
+    );
+  } else {
+    vector<thread> thread_group;
+    for (int thread_idx = 0; thread_idx < num_threads; ++thread_idx) {
+      thread_group.emplace_back(compute_betweenness_centrality_csr_helper,
+                                &graph, &partial_centrality[thread_idx],
+                                &partial_paths[thread_idx], &next_source,
+                                thread_idx, num_threads, verbose, queue);
     }
 
-    // single-shortest-path
-    dijkstra(graph, it->second);
-
-    // accumulation
-    while (graph->hasDistanceOrderedVertices()) {
-      Vertex* w = graph->popDistanceOrderedVertex();
-
-      for (Vertex* v : w->getCentralityParents()) {
-        graph->incrementPathCounter();
-        if (w->getCentrality() == 0) continue;
+    // Aggregate the results of each thread into the first thread's scores
+    for (int thread_idx = 0; thread_idx < num_threads; ++thread_idx) {
+      thread_group[thread_idx].join();
+      if (thread_idx == 0) continue;
 
-        v->incrementDependency((v->getCentrality() / w->getCentrality()) * (1 + w->getDependency()));
-      }
-
-      // only add centrality to paths that do not start/end at the starting vertex
-      if (w != it->second) {
-        // divide by because its an undirected graph so each edge is counted
-        // twice (since algo is for directed graphs)
-        betweenness_centrality[w->getAddress()] += w->getDependency() / 2.0;
+      for (uint32_t v = 0; v < graph.numVertices(); ++v) {
+        partial_centrality[0][v] += partial_centrality[thread_idx][v];
       }
     }
+  }
 
-    // increment the iterator by the number of threads to avoid overlapping 
-    // computation between multiple threads
-    counter = 0;
-    while (it != end && counter < num_threads) {
-      ++it;
-      ++counter;
-    }
+  // every path between two vertices was counted once from each end
+  if (num_shortest_paths != NULL) {
+    *num_shortest_paths = 0.0;
+    for (double paths : partial_paths) *num_shortest_paths += paths / 2.0;
   }
 
-  delete graph;
-  thread_result.set_value(betweenness_centrality);
+  return move(partial_centrality[0]);
 }
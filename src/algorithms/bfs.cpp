@@ -1,59 +1,270 @@
 #include "algorithms/bfs.h"
+#include "algorithms/bitmap.h"
 #include "utils/utils.h"
 
 #include <iostream>
-#include <queue>
+#include <chrono>
 
-using std::string;
 using std::vector;
-using std::queue;
 using std::pair;
 using std::cout;
 using std::endl;
 
-int bfs(Graph* g) {
-  // Set all vertices as unexplored to start
-  for (pair<string, Vertex*> p : g->getVertices()) {
-    p.second->reset();
+/**
+ * @brief Switch a search to bottom-up steps once the edges leaving the
+ * frontier exceed 1 / ALPHA of the edges incident to unexplored vertices, as
+ * proposed by Beamer et al.
+ */
+static const uint64_t ALPHA = 15;
+
+/**
+ * @brief Only take bottom-up steps while the frontier holds at least
+ * 1 / BETA of the vertices of the graph. A bottom-up step sweeps over every
+ * vertex, which only pays off when a large share of them is in the frontier.
+ */
+static const uint64_t BETA = 18;
+
+/**
+ * @brief The number of largest components run_bfs prints a summary of.
+ */
+static const size_t NUM_COMPONENTS_TO_PRINT = 5;
+
+/**
+ * @brief Gives the BFS kernel access to the neighbors of each vertex of a
+ * CSRGraph.
+ */
+struct CSRAdjacency {
+  const CSRGraph& g;
+
+  uint32_t numVertices() const { return g.numVertices(); }
+  uint64_t numEndpoints() const { return g.offset(g.numVertices()); }
+  uint64_t degree(uint32_t v) const { return g.degree(v); }
+
+  /**
+   * @brief Call f on each neighbor of v until it returns true.
+   */
+  template <typename F>
+  void forEachNeighbor(uint32_t v, F f) const {
+    for (uint64_t i = g.offset(v); i < g.offset(v + 1); ++i) {
+      if (f(g.neighbor(i))) return;
+    }
+  }
+};
+
+/**
+ * @brief Gives the BFS kernel access to the neighbors of each vertex of a
+ * Graph through the dense vertex IDs of the graph.
+ */
+struct GraphAdjacency {
+  const Graph& g;
+
+  uint32_t numVertices() const { return g.numVertices(); }
+  uint64_t numEndpoints() const { return 2 * g.getEdges().size(); }
+  uint64_t degree(uint32_t v) const {
+    return g.getVertexById(v)->getIncidentEdges().size();
   }
 
-  // Set all edges as unexplored to start
-  for (Edge* e : g->getEdges()) {
-    e->setExplored(false);
+  /**
+   * @brief Call f on each neighbor of v until it returns true.
+   */
+  template <typename F>
+  void forEachNeighbor(uint32_t v, F f) const {
+    Vertex* vertex = g.getVertexById(v);
+    for (Edge* incident : vertex->getIncidentEdges()) {
+      if (f(incident->getAdjacentVertex(vertex)->getId())) return;
+    }
   }
+};
+
+/**
+ * @brief Gives the BFS kernel access to the neighbors of each vertex of the
+ * subgraph seen through a SubgraphView, by local ID. Edges leaving the view
+ * are skipped.
+ */
+struct ViewAdjacency {
+  const CSRGraph& g;
+  const SubgraphView& view;
+
+  uint32_t numVertices() const { return view.numVertices(); }
+  uint64_t degree(uint32_t v) const { return g.degree(view.toParent(v)); }
+
+  // degrees count edges leaving the view too, which only makes the kernel
+  // slightly less eager to switch to bottom-up steps
+  uint64_t numEndpoints() const {
+    uint64_t total = 0;
+    for (uint32_t p : view.members()) total += g.degree(p);
+    return total;
+  }
+
+  /**
+   * @brief Call f on each neighbor of v within the view until it returns
+   * true.
+   */
+  template <typename F>
+  void forEachNeighbor(uint32_t v, F f) const {
+    uint32_t p = view.toParent(v);
+    for (uint64_t i = g.offset(p); i < g.offset(p + 1); ++i) {
+      uint32_t local = view.toLocal(g.neighbor(i));
+      if (local != SubgraphView::NO_VERTEX && f(local)) return;
+    }
+  }
+};
+
+/**
+ * @brief The state shared by the BFS traversals of every component of a graph.
+ */
+struct BFSState {
+  template <typename Adjacency>
+  explicit BFSState(const Adjacency& g)
+    : explored(g.numVertices()), frontier(), 
+      unexplored_endpoints(g.numEndpoints()) { }
+
+  /**
+   * @brief The vertices reached by any traversal so far.
+   */
+  Bitmap explored;
+
+  /**
+   * @brief The frontier of a bottom-up step, allocated by the first one.
+   */
+  Bitmap frontier;
+
+  /**
+   * @brief The sum of the degrees of the vertices not yet reached.
+   */
+  uint64_t unexplored_endpoints;
+};
+
+/**
+ * @brief Run a direction-optimizing BFS over the connected component 
+ * containing the passed vertex, appending every vertex reached to the passed
+ * vector. The vector doubles as the BFS queue, with each level stored after
+ * the one before it.
+ *
+ * Levels are expanded top-down, by scanning the edges of the frontier for
+ * unexplored vertices, while the frontier is small. Once it holds a large
+ * share of the graph and its edges outnumber those of the unexplored
+ * vertices, levels are expanded bottom-up instead: every unexplored vertex
+ * checks its own edges for a member of the frontier, stopping at the first
+ * one found. On graphs dominated by hubs this skips most of the edges in the
+ * largest levels.
+ *
+ * @param g the graph to search, wrapped in CSRAdjacency or GraphAdjacency.
+ * @param start the ID of the vertex to begin the search from.
+ * @param state the explored bitmap and frontier shared across components.
+ * @param component a vector that the IDs of reached vertices are appended to.
+ */
+template <typename Adjacency>
+static void bfs_component(const Adjacency& g, uint32_t start, BFSState& state,
+                          vector<uint32_t>& component) {
+  uint64_t n = g.numVertices();
+  size_t level_begin = component.size();
+
+  state.explored.set(start);
+  state.unexplored_endpoints -= g.degree(start);
+  component.push_back(start);
+
+  uint64_t frontier_endpoints = g.degree(start);
+  bool bottom_up = false;
+
+  while (level_begin < component.size()) {
+    size_t level_end = component.size();
+    uint64_t frontier_size = level_end - level_begin;
+
+    bottom_up = frontier_size * BETA >= n && (bottom_up || 
+                frontier_endpoints * ALPHA > state.unexplored_endpoints);
+    frontier_endpoints = 0;
+
+    if (bottom_up) {
+      if (state.frontier.size() != n) state.frontier = Bitmap(n);
+      state.frontier.clear();
+      for (size_t i = level_begin; i < level_end; ++i) {
+        state.frontier.set(component[i]);
+      }
+
+      for (uint32_t w = 0; w < state.explored.numWords(); ++w) {
+        uint64_t unexplored = ~state.explored.word(w);
+        if (w == state.explored.numWords() - 1 && n % 64 != 0) {
+          unexplored &= (uint64_t(1) << (n % 64)) - 1;
+        }
+
+        while (unexplored != 0) {
+          uint32_t v = w * 64 + __builtin_ctzll(unexplored);
+          unexplored &= unexplored - 1;
+
+          g.forEachNeighbor(v, [&](uint32_t adjacent) {
+            if (!state.frontier.get(adjacent)) return false;
+
+            state.explored.set(v);
+            component.push_back(v);
+            return true;
+          });
+        }
+      }
+    } else {
+      for (size_t i = level_begin; i < level_end; ++i) {
+        g.forEachNeighbor(component[i], [&](uint32_t adjacent) {
+          if (!state.explored.get(adjacent)) {
+            state.explored.set(adjacent);
+            component.push_back(adjacent);
+          }
+          return false;
+        });
+      }
+    }
+
+    for (size_t i = level_end; i < component.size(); ++i) {
+      uint64_t degree = g.degree(component[i]);
+      frontier_endpoints += degree;
+      state.unexplored_endpoints -= degree;
+    }
+
+    level_begin = level_end;
+  }
+}
+
+int bfs(Graph* g, bool mark_edges) {
+  GraphAdjacency adjacency{*g};
+  BFSState state(adjacency);
+  vector<uint32_t> component;
 
   int num_connected_components = 0;
 
   // Run BFS on each connected component of the graph
-  for (pair<string, Vertex*> p : g->getVertices()) {
-    if (!p.second->wasExplored()) {
-      bfs(g, p.second);
+  for (uint32_t v = 0; v < g->numVertices(); ++v) {
+    if (!state.explored.get(v)) {
+      component.clear();
+      bfs_component(adjacency, v, state, component);
       ++num_connected_components;
     }
   }
 
+  // every vertex and edge lies in some component, so all of them were reached
+  for (uint32_t v = 0; v < g->numVertices(); ++v) {
+    g->getVertexById(v)->setExplored(true);
+  }
+
+  if (mark_edges) {
+    for (Edge* e : g->getEdges()) e->setExplored(true);
+  }
+
   return num_connected_components;
 }
 
-int bfs(Graph* g, Vertex* start) {
-  queue<Vertex*> q;
-  start->setExplored(true);
-  q.push(start);
-
-  while (!q.empty()) {
-    Vertex* v = q.front();
-    q.pop();
-
-    for (Edge* indicent : v->getIncidentEdges()) {
-      indicent->setExplored(true);
-      Vertex* adjacent = indicent->getAdjacentVertex(v);
-      if (!adjacent->wasExplored()) {
-        // set indicent as discovery edge
-        adjacent->setExplored(true);
-        q.push(adjacent);
-      } /*else if (indicent->wasExplored()) {
-        // set indicent as cross edge
-      } */
+int bfs(Graph* g, Vertex* start, bool mark_edges) {
+  GraphAdjacency adjacency{*g};
+  BFSState state(adjacency);
+  vector<uint32_t> component;
+  bfs_component(adjacency, start->getId(), state, component);
+
+  for (uint32_t v : component) {
+    Vertex* vertex = g->getVertexById(v);
+    vertex->setExplored(true);
+
+    if (mark_edges) {
+      for (Edge* incident : vertex->getIncidentEdges()) {
+        incident->setExplored(true);
+      }
     }
   }
 
@@ -62,131 +273,173 @@ int bfs(Graph* g, Vertex* start) {
   return 1; 
 }
 
-void run_bfs(Graph* g) {
+ComponentCensus run_bfs(const Graph& g, const CSRGraph& csr, int num_threads,
+                        bool validate) {
   //////////////////////////////////////////////////////////////////////////////
-  ///         Ensure all vertices HAVE NOT been explored BEFORE BFS          ///
+  ///            Find the connected components of graph and count them       ///
   //////////////////////////////////////////////////////////////////////////////
-  bool vertices_explored = false;
-  for (pair<string, Vertex*> p : g->getVertices()) {
-    vertices_explored |= p.second->wasExplored();
-  }
-
-  if (!vertices_explored)
-    cout << GREEN << "No vertices have been explored." << RESET << endl;
-  else
-    cout << BOLDRED << "One or more vertices has been explored." << RESET << endl;
+  cout << "\nFinding connected components..." << endl;
+  auto wall_start = std::chrono::steady_clock::now();
+  Components components = connected_components(csr, num_threads);
+  ComponentCensus census = ComponentCensus::take(g, components);
+  std::chrono::duration<double> wall_elapsed = 
+    std::chrono::steady_clock::now() - wall_start;
+  print_wall_elapsed(wall_elapsed.count(), "finding connected components");
+  cout << "There are " << census.numComponents()
+       << " connected components in the graph.\n" << endl;
 
-  //////////////////////////////////////////////////////////////////////////////
-  ///           Ensure all edges HAVE NOT been explored BEFORE BFS           ///
-  //////////////////////////////////////////////////////////////////////////////
-  bool edges_explored = false;
-  for (Edge* e : g->getEdges()) {
-    edges_explored |= e->wasExplored();
+  for (uint32_t c : census.largest(NUM_COMPONENTS_TO_PRINT)) {
+    cout << YELLOW << "Component " << c << " contains " 
+         << census.numVertices(c) << " vertices and " << census.numEdges(c) 
+         << " edges using " << census.totalGas(c) << " gas." << RESET << endl;
   }
 
-  if (!edges_explored)
-    cout << GREEN << "No edges have been explored." << RESET << endl;
-  else
-    cout << BOLDRED << "One or more edges has been explored." << RESET << endl;
-
-  //////////////////////////////////////////////////////////////////////////////
-  ///                            Run BFS on graph                            ///
-  //////////////////////////////////////////////////////////////////////////////
-  cout << "\nRunning BFS..." << endl;
-  clock_t c1, c2;
-  c1 = clock();
-  int num_connected_components = bfs(g);
-  c2 = clock();
-  print_elapsed(c1, c2, "BFS");
-  cout << "There are " << num_connected_components
-       << " connected components in the graph.\n" << endl;
+  if (!validate) return census;
+  cout << endl;
 
   //////////////////////////////////////////////////////////////////////////////
-  ///            Ensure all vertices HAVE been explored AFTER BFS            ///
+  ///          Ensure every vertex was counted in exactly one component      ///
   //////////////////////////////////////////////////////////////////////////////
-  vertices_explored = true;
-  for (pair<string, Vertex*> p : g->getVertices()) {
-    vertices_explored &= p.second->wasExplored();
-  }
+  uint64_t num_counted = 0;
+  for (uint32_t size : components.sizes) num_counted += size;
 
-  if (vertices_explored)
+  if (num_counted == csr.numVertices())
     cout << GREEN << "All vertices have been explored." << RESET << endl;
   else
     cout << BOLDRED << "One or more vertices was not explored." << RESET << endl;
 
   //////////////////////////////////////////////////////////////////////////////
-  ///             Ensure all edges HAVE been explored AFTER BFS              ///
+  ///           Ensure every edge lies within a single component             ///
   //////////////////////////////////////////////////////////////////////////////
-  edges_explored = true;
-  for (Edge* e : g->getEdges()) {
-    edges_explored &= e->wasExplored();
+  bool edges_explored = true;
+  for (Edge* e : g.getEdges()) {
+    edges_explored &= components.labels[e->getSource()->getId()] == 
+                      components.labels[e->getDestination()->getId()];
   }
 
   if (edges_explored)
     cout << GREEN << "All edges have been explored." << RESET << endl;
   else
     cout << BOLDRED << "One or more edges was not explored." << RESET << endl;
+
+  return census;
 }
 
 vector<Vertex*> find_largest_component(Graph* g) {
-  // Set all vertices as unexplored to start
-  for (pair<string, Vertex*> p : g->getVertices()) {
-    p.second->reset();
+  GraphAdjacency adjacency{*g};
+  BFSState state(adjacency);
+  vector<uint32_t> component, largest_connected_component;
+
+  // Run BFS on each connected component of the graph
+  for (uint32_t v = 0; v < g->numVertices(); ++v) {
+    if (!state.explored.get(v)) {
+      component.clear();
+      bfs_component(adjacency, v, state, component);
+
+      if (component.size() > largest_connected_component.size()) {
+        largest_connected_component.swap(component);
+      }
+    }
   }
 
-  // Set all edges as unexplored to start
-  for (Edge* e : g->getEdges()) {
-    e->setExplored(false);
+  vector<Vertex*> result;
+  result.reserve(largest_connected_component.size());
+  for (uint32_t v : largest_connected_component) {
+    result.push_back(g->getVertexById(v));
   }
 
-  vector<Vertex*> largest_connected_component;
+  return result;
+}
 
-  // Run BFS on each connected component of the graph
-  for (pair<string, Vertex*> p : g->getVertices()) {
-    if (!p.second->wasExplored()) {
-      vector<Vertex*> result = find_largest_component(g, p.second);
+vector<Vertex*> find_largest_component(Graph* g, Vertex* start) {
+  GraphAdjacency adjacency{*g};
+  BFSState state(adjacency);
+  vector<uint32_t> component;
+  bfs_component(adjacency, start->getId(), state, component);
 
-      if (result.size() > largest_connected_component.size()) {
-        largest_connected_component = result;
-      }
+  vector<Vertex*> result;
+  result.reserve(component.size());
+  for (uint32_t v : component) result.push_back(g->getVertexById(v));
+
+  return result;  
+}
+
+int bfs(const CSRGraph& g) {
+  CSRAdjacency adjacency{g};
+  BFSState state(adjacency);
+  vector<uint32_t> component;
+  component.reserve(g.numVertices());
+
+  int num_connected_components = 0;
+
+  // Run BFS on each connected component of the graph
+  for (uint32_t v = 0; v < g.numVertices(); ++v) {
+    if (!state.explored.get(v)) {
+      component.clear();
+      bfs_component(adjacency, v, state, component);
+      ++num_connected_components;
     }
   }
 
-  // Set all vertices as unexplored to reset
-  for (pair<string, Vertex*> p : g->getVertices()) {
-    p.second->setExplored(false);
+  return num_connected_components;
+}
+
+int bfs(const CSRGraph& g, const SubgraphView& view) {
+  ViewAdjacency adjacency{g, view};
+  BFSState state(adjacency);
+  vector<uint32_t> component;
+  component.reserve(view.numVertices());
+
+  int num_connected_components = 0;
+
+  // Run BFS on each connected component of the subgraph
+  for (uint32_t v = 0; v < view.numVertices(); ++v) {
+    if (!state.explored.get(v)) {
+      component.clear();
+      bfs_component(adjacency, v, state, component);
+      ++num_connected_components;
+    }
   }
 
-  // Set all edges as unexplored to reset
-  for (Edge* e : g->getEdges()) {
-    e->setExplored(false);
+  return num_connected_components;
+}
+
+vector<uint32_t> find_largest_component(const CSRGraph& g) {
+  CSRAdjacency adjacency{g};
+  BFSState state(adjacency);
+  vector<uint32_t> component, largest_connected_component;
+
+  // Run BFS on each connected component of the graph
+  for (uint32_t v = 0; v < g.numVertices(); ++v) {
+    if (!state.explored.get(v)) {
+      component.clear();
+      bfs_component(adjacency, v, state, component);
+
+      if (component.size() > largest_connected_component.size()) {
+        largest_connected_component.swap(component);
+      }
+    }
   }
 
   return largest_connected_component;
 }
 
-vector<Vertex*> find_largest_component(Graph* g, Vertex* start) {
-  queue<Vertex*> q;
-  start->setExplored(true);
-  q.push(start);
+vector<uint32_t> label_components(const CSRGraph& g, vector<uint32_t>& sizes) {
+  CSRAdjacency adjacency{g};
+  BFSState state(adjacency);
+  vector<uint32_t> labels(g.numVertices()), component;
+  component.reserve(g.numVertices());
+  sizes.clear();
 
-  vector<Vertex*> result;
-  result.push_back(start);
-
-  while (!q.empty()) {
-    Vertex* v = q.front();
-    q.pop();
-
-    for (Edge* indicent : v->getIncidentEdges()) {
-      indicent->setExplored(true);
-      Vertex* adjacent = indicent->getAdjacentVertex(v);
-      if (!adjacent->wasExplored()) {
-        result.push_back(adjacent);
-        adjacent->setExplored(true);
-        q.push(adjacent);
-      }
+  for (uint32_t v = 0; v < g.numVertices(); ++v) {
+    if (!state.explored.get(v)) {
+      component.clear();
+      bfs_component(adjacency, v, state, component);
+
+      for (uint32_t u : component) labels[u] = sizes.size();
+      sizes.push_back(component.size());
     }
   }
 
-  return result;  
+  return labels;
 }
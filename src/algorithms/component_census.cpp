@@ -0,0 +1,126 @@
+#include "algorithms/component_census.h"
+#include "core/snapshot.h"
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+#include <map>
+
+using std::ofstream;
+using std::string;
+using std::vector;
+using std::pair;
+using std::map;
+
+ComponentCensus ComponentCensus::take(const Graph& g,
+                                      const Components& components) {
+  ComponentCensus census;
+  size_t num_components = components.sizes.size();
+
+  census.num_vertices_ = components.sizes;
+  census.num_edges_.assign(num_components, 0);
+  census.total_gas_.assign(num_components, 0);
+  census.total_value_.assign(num_components, 0.0);
+
+  // both endpoints of an edge lie in the same component
+  for (Edge* e : g.getEdges()) {
+    uint32_t c = components.labels[e->getSource()->getId()];
+    ++census.num_edges_[c];
+    census.total_gas_[c] += e->getGas();
+    census.total_value_[c] += e->getValue();
+  }
+
+  return census;
+}
+
+vector<pair<uint32_t, uint32_t>> ComponentCensus::sizeHistogram() const {
+  map<uint32_t, uint32_t> counts;
+  for (uint32_t size : num_vertices_) ++counts[size];
+
+  return vector<pair<uint32_t, uint32_t>>(counts.begin(), counts.end());
+}
+
+vector<uint32_t> ComponentCensus::largest(size_t k) const {
+  vector<uint32_t> order(numComponents());
+  for (uint32_t c = 0; c < order.size(); ++c) order[c] = c;
+
+  k = std::min(k, order.size());
+  std::partial_sort(order.begin(), order.begin() + k, order.end(),
+    [&](uint32_t a, uint32_t b) {
+      return num_vertices_[a] != num_vertices_[b]
+        ? num_vertices_[a] > num_vertices_[b] : a < b;
+    });
+
+  order.resize(k);
+  return order;
+}
+
+bool ComponentCensus::saveCsv(const string& path) const {
+  ofstream of(path, std::ios::trunc);
+  if (!of.is_open()) return false;
+
+  // write values with enough digits to read back the same double
+  of.precision(17);
+  of << "component,vertices,edges,total_gas,total_value\n";
+  for (uint32_t c = 0; c < numComponents(); ++c) {
+    of << c << "," << num_vertices_[c] << "," << num_edges_[c] << ","
+       << total_gas_[c] << "," << total_value_[c] << "\n";
+  }
+
+  return of.good();
+}
+
+bool ComponentCensus::save(const string& path) const {
+  ofstream of(path, std::ios::binary | std::ios::trunc);
+  if (!of.is_open()) return false;
+
+  CensusHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, CENSUS_MAGIC, sizeof(header.magic));
+  header.version = CENSUS_VERSION;
+  header.header_size = sizeof(CensusHeader);
+  header.num_components = numComponents();
+
+  of.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  snapshot_write_array(of, num_vertices_);
+  snapshot_write_array(of, num_edges_);
+  snapshot_write_array(of, total_gas_);
+  snapshot_write_array(of, total_value_);
+
+  return of.good();
+}
+
+bool ComponentCensus::load(const string& path, ComponentCensus& census) {
+  MappedFile file(path);
+  if (!file.isOpen() || file.size() < sizeof(CensusHeader)) return false;
+
+  const CensusHeader* header =
+    reinterpret_cast<const CensusHeader*>(file.data());
+
+  if (memcmp(header->magic, CENSUS_MAGIC, sizeof(header->magic)) != 0
+      || header->version != CENSUS_VERSION
+      || header->header_size < sizeof(CensusHeader)
+      || header->header_size % 8 != 0) {
+    return false;
+  }
+
+  size_t n = header->num_components;
+  size_t offset = header->header_size;
+  const uint32_t* num_vertices;
+  const uint64_t* num_edges;
+  const uint64_t* total_gas;
+  const double* total_value;
+
+  bool complete = snapshot_read_array(file, offset, n, num_vertices)
+    && snapshot_read_array(file, offset, n, num_edges)
+    && snapshot_read_array(file, offset, n, total_gas)
+    && snapshot_read_array(file, offset, n, total_value);
+  if (!complete) return false;
+
+  census.num_vertices_.assign(num_vertices, num_vertices + n);
+  census.num_edges_.assign(num_edges, num_edges + n);
+  census.total_gas_.assign(total_gas, total_gas + n);
+  census.total_value_.assign(total_value, total_value + n);
+
+  return true;
+}
@@ -0,0 +1,177 @@
+#include "algorithms/connected_components.h"
+#include "utils/thread_pool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <random>
+#include <unordered_map>
+
+using std::unordered_map;
+using std::atomic;
+using std::vector;
+
+/**
+ * @brief The number of vertices each parallel task links or compresses.
+ */
+static const size_t VERTICES_PER_TASK = 4096;
+
+/**
+ * @brief The number of leading neighbors of every vertex linked before the
+ * largest component is estimated.
+ */
+static const uint32_t NEIGHBOR_ROUNDS = 2;
+
+/**
+ * @brief The number of vertices sampled to estimate the largest component.
+ */
+static const uint32_t NUM_SAMPLES = 1024;
+
+/**
+ * @brief Merge the trees containing the two passed vertices by hooking the
+ * root with the higher ID below the other root. Another thread may hook
+ * either root first, in which case the roots are found again and retried.
+ *
+ * @param parent the parent of every vertex in the union-find forest.
+ * @param u a uint32_t indicating the ID of a vertex.
+ * @param v a uint32_t indicating the ID of a vertex.
+ */
+static void link(vector<atomic<uint32_t>>& parent, uint32_t u, uint32_t v) {
+  uint32_t p1 = parent[u].load();
+  uint32_t p2 = parent[v].load();
+
+  while (p1 != p2) {
+    uint32_t high = std::max(p1, p2);
+    uint32_t low = std::min(p1, p2);
+    uint32_t p_high = parent[high].load();
+
+    // already hooked below low, possibly by another thread
+    if (p_high == low) break;
+    if (p_high == high && parent[high].compare_exchange_strong(p_high, low)) {
+      break;
+    }
+
+    p1 = parent[parent[high].load()].load();
+    p2 = parent[low].load();
+  }
+}
+
+/**
+ * @brief Point every vertex of the passed range directly at the root of its
+ * tree.
+ */
+static void compress(vector<atomic<uint32_t>>& parent, uint32_t begin,
+                     uint32_t end) {
+  for (uint32_t v = begin; v < end; ++v) {
+    uint32_t p = parent[v].load();
+    while (p != parent[p].load()) {
+      p = parent[p].load();
+      parent[v].store(p);
+    }
+  }
+}
+
+Components connected_components(const CSRGraph& g, int num_threads) {
+  uint32_t n = g.numVertices();
+  ThreadPool pool(std::max(num_threads, 1));
+  vector<atomic<uint32_t>> parent(n);
+
+  // run fn(begin, end) over every range of vertices in parallel
+  auto parallel_ranges = [&](auto fn) {
+    pool.parallelForRange(n, VERTICES_PER_TASK, 
+                          [&](size_t begin, size_t end, int) {
+      fn(begin, end);
+    });
+  };
+
+  parallel_ranges([&](uint32_t begin, uint32_t end) {
+    for (uint32_t v = begin; v < end; ++v) parent[v].store(v);
+  });
+
+  // link each vertex to its first few neighbors, one neighbor per round
+  for (uint32_t round = 0; round < NEIGHBOR_ROUNDS; ++round) {
+    parallel_ranges([&](uint32_t begin, uint32_t end) {
+      for (uint32_t v = begin; v < end; ++v) {
+        if (round < g.degree(v)) {
+          link(parent, v, g.neighbor(g.offset(v) + round));
+        }
+      }
+    });
+
+    parallel_ranges([&](uint32_t begin, uint32_t end) {
+      compress(parent, begin, end);
+    });
+  }
+
+  // estimate the largest component by sampling the roots of random vertices
+  uint32_t largest_root = 0;
+  if (n != 0) {
+    std::mt19937 rng(0);
+    std::uniform_int_distribution<uint32_t> random_vertex(0, n - 1);
+    unordered_map<uint32_t, uint32_t> counts;
+    uint32_t most_samples = 0;
+
+    for (uint32_t i = 0; i < NUM_SAMPLES; ++i) {
+      uint32_t root = parent[random_vertex(rng)].load();
+      if (++counts[root] > most_samples) {
+        most_samples = counts[root];
+        largest_root = root;
+      }
+    }
+  }
+
+  // every edge is stored in both directions, so an edge between a vertex in
+  // the largest component and one outside of it is linked by the latter
+  parallel_ranges([&](uint32_t begin, uint32_t end) {
+    for (uint32_t v = begin; v < end; ++v) {
+      if (parent[v].load() == largest_root) continue;
+
+      for (uint64_t i = g.offset(v) + NEIGHBOR_ROUNDS; i < g.offset(v + 1);
+           ++i) {
+        link(parent, v, g.neighbor(i));
+      }
+    }
+  });
+
+  parallel_ranges([&](uint32_t begin, uint32_t end) {
+    compress(parent, begin, end);
+  });
+
+  // the root of each tree is its lowest vertex, so roots are numbered before
+  // the rest of their component is reached
+  Components result;
+  result.labels.resize(n);
+
+  for (uint32_t v = 0; v < n; ++v) {
+    uint32_t root = parent[v].load();
+
+    if (root == v) {
+      result.labels[v] = result.sizes.size();
+      result.sizes.push_back(0);
+    } else {
+      result.labels[v] = result.labels[root];
+    }
+
+    ++result.sizes[result.labels[v]];
+  }
+
+  for (uint32_t c = 0; c < result.sizes.size(); ++c) {
+    if (result.largest == Components::NO_COMPONENT ||
+        result.sizes[c] > result.sizes[result.largest]) {
+      result.largest = c;
+    }
+  }
+
+  return result;
+}
+
+vector<uint32_t> component_members(const Components& components,
+                                   uint32_t component) {
+  vector<uint32_t> members;
+  members.reserve(components.sizes[component]);
+
+  for (uint32_t v = 0; v < components.labels.size(); ++v) {
+    if (components.labels[v] == component) members.push_back(v);
+  }
+
+  return members;
+}
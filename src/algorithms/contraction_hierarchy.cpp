@@ -0,0 +1,615 @@
+#include "algorithms/contraction_hierarchy.h"
+#include "algorithms/indexed_heap.h"
+#include "utils/thread_pool.h"
+#include "core/snapshot.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
+using std::unique_ptr;
+using std::ofstream;
+using std::string;
+using std::vector;
+using std::pair;
+
+static const uint64_t UNREACHED = TraversalWorkspace::UNREACHED;
+static const uint32_t NO_VERTEX = TraversalWorkspace::NO_VERTEX;
+
+/**
+ * @brief The most edges a witness search relaxes before giving up. A search
+ * that gives up only causes shortcuts that may be unnecessary to be added, so
+ * this trades a few extra shortcuts for a bounded contraction time. Edges are
+ * counted rather than vertices because settling a single exchange can mean
+ * relaxing tens of thousands of edges.
+ */
+static const uint32_t WITNESS_EDGE_LIMIT = 1000;
+
+/**
+ * @brief The largest number of remaining neighbors a vertex may have and still
+ * be contracted. Contracting a vertex of degree d can add d * (d - 1) / 2
+ * shortcuts, so vertices above this degree, such as exchanges and popular
+ * contracts, are left uncontracted in the core of the hierarchy.
+ */
+static const uint32_t MAX_CONTRACTED_DEGREE = 64;
+
+/**
+ * @brief The priority of a vertex that is too well connected to contract.
+ */
+static const int64_t CORE = INT64_MAX;
+
+namespace {
+
+/**
+ * @brief An edge of the graph while it is being contracted, which leads to a
+ * vertex that has not been contracted yet. Shortcuts record the contracted
+ * vertex they skip as their middle.
+ */
+struct Arc {
+  uint32_t target;
+  uint32_t middle;
+  uint64_t weight;
+};
+
+/**
+ * @brief A shortcut between two neighbors of a vertex being contracted.
+ */
+struct Shortcut {
+  uint32_t from;
+  uint32_t to;
+  uint64_t weight;
+};
+
+/**
+ * @brief A Dijkstra search over the remaining graph that looks for a path
+ * between two neighbors of a vertex that avoids the vertex ("a witness"). If
+ * such a path is no longer than the path through the vertex, contracting the
+ * vertex does not need a shortcut between the two. Each thread owns one.
+ */
+class WitnessSearch {
+  public:
+    explicit WitnessSearch(uint32_t size)
+      : distances_(size, UNREACHED), epochs_(size, 0), epoch_(0),
+        heap_(size) { }
+
+    /**
+     * @brief Find the distances from the passed source to the vertices at
+     * most limit away, without passing through skip or any excluded vertex.
+     * Only the edges from vertices too well connected to contract to the 
+     * passed targets are relaxed, which are found from the side of the 
+     * targets, so a witness path may pass through an exchange without the
+     * search relaxing every edge of the exchange.
+     */
+    void run(const vector<vector<Arc>>& adjacency, uint32_t source,
+             uint32_t skip, const vector<uint8_t>& excluded, uint64_t limit,
+             const vector<Arc>& targets) {
+      if (++epoch_ == 0) {
+        std::fill(epochs_.begin(), epochs_.end(), 0);
+        epoch_ = 1;
+      }
+
+      setDistance(source, 0);
+      heap_.pushOrDecrease(source, 0);
+      uint32_t relaxed = 0;
+
+      while (!heap_.empty() && relaxed < WITNESS_EDGE_LIMIT) {
+        uint64_t distance = heap_.top().first;
+        uint32_t u = heap_.top().second;
+        if (distance > limit) break;
+        heap_.pop();
+
+        if (adjacency[u].size() > MAX_CONTRACTED_DEGREE) {
+          for (const Arc& target : targets) {
+            const vector<Arc>& arcs = adjacency[target.target];
+            if (arcs.size() > MAX_CONTRACTED_DEGREE) continue;
+
+            relaxed += arcs.size();
+            for (const Arc& arc : arcs) {
+              if (arc.target == u) {
+                relax(target.target, distance + arc.weight);
+                break;
+              }
+            }
+          }
+
+          continue;
+        }
+
+        for (const Arc& arc : adjacency[u]) {
+          if (relaxed++ == WITNESS_EDGE_LIMIT) break;
+          if (arc.target == skip || excluded[arc.target]) continue;
+          relax(arc.target, distance + arc.weight);
+        }
+      }
+
+      heap_.clear();
+    }
+
+    /**
+     * @brief Get the distance found to the passed vertex by the last search,
+     * or UNREACHED if it was not reached within the limits.
+     */
+    uint64_t getDistance(uint32_t v) const {
+      return epochs_[v] == epoch_ ? distances_[v] : UNREACHED;
+    }
+  private:
+    void relax(uint32_t v, uint64_t distance) {
+      if (distance < getDistance(v)) {
+        setDistance(v, distance);
+        heap_.pushOrDecrease(v, distance);
+      }
+    }
+
+    void setDistance(uint32_t v, uint64_t distance) {
+      distances_[v] = distance;
+      epochs_[v] = epoch_;
+    }
+
+    vector<uint64_t> distances_;
+    vector<uint32_t> epochs_;
+    uint32_t epoch_;
+    IndexedHeap heap_;
+};
+
+} // namespace
+
+/**
+ * @brief Find the shortcuts needed to contract the passed vertex: one for every
+ * pair of its neighbors whose only shortest path within the searched area runs
+ * through the vertex.
+ */
+static void find_shortcuts(const vector<vector<Arc>>& adjacency, uint32_t v,
+                           const vector<uint8_t>& excluded,
+                           WitnessSearch& search, vector<Shortcut>& shortcuts) {
+  shortcuts.clear();
+  const vector<Arc>& arcs = adjacency[v];
+
+  uint64_t max_weight = 0;
+  for (const Arc& arc : arcs) max_weight = std::max(max_weight, arc.weight);
+
+  for (size_t i = 0; i + 1 < arcs.size(); ++i) {
+    search.run(adjacency, arcs[i].target, v, excluded,
+               arcs[i].weight + max_weight, arcs);
+
+    for (size_t j = i + 1; j < arcs.size(); ++j) {
+      uint64_t via = arcs[i].weight + arcs[j].weight;
+      if (search.getDistance(arcs[j].target) > via) {
+        shortcuts.push_back({arcs[i].target, arcs[j].target, via});
+      }
+    }
+  }
+}
+
+/**
+ * @brief Add an arc to the passed adjacency list, or shorten the arc already
+ * leading to the same vertex.
+ */
+static void add_arc(vector<Arc>& arcs, const Arc& arc) {
+  for (Arc& existing : arcs) {
+    if (existing.target == arc.target) {
+      if (arc.weight < existing.weight) existing = arc;
+      return;
+    }
+  }
+
+  arcs.push_back(arc);
+}
+
+/**
+ * @brief Remove the arc leading to the passed vertex from the passed adjacency
+ * list.
+ */
+static void remove_arc(vector<Arc>& arcs, uint32_t target) {
+  for (Arc& arc : arcs) {
+    if (arc.target == target) {
+      arc = arcs.back();
+      arcs.pop_back();
+      return;
+    }
+  }
+}
+
+/**
+ * @brief Hash the neighbors and edge weights of the passed graph with FNV-1a,
+ * so that a saved hierarchy is never used with a graph it was not built for.
+ */
+static uint64_t graph_fingerprint(const CSRGraph& g) {
+  uint64_t hash = 14695981039346656037ULL;
+  auto mix = [&hash](uint64_t value) {
+    hash ^= value;
+    hash *= 1099511628211ULL;
+  };
+
+  for (uint32_t v = 0; v < g.numVertices(); ++v) {
+    mix(g.degree(v));
+    for (uint64_t i = g.offset(v); i < g.offset(v + 1); ++i) {
+      mix(g.neighbor(i));
+      mix(g.weight(i));
+    }
+  }
+
+  return hash;
+}
+
+ContractionHierarchy::ContractionHierarchy()
+  : rank_(), up_offsets_(1, 0), up_targets_(), up_middles_(), up_weights_() { }
+
+ContractionHierarchy ContractionHierarchy::build(const CSRGraph& g,
+                                                 int num_threads) {
+  uint32_t n = g.numVertices();
+
+  // the remaining graph, without self loops and keeping only the lightest of
+  // parallel edges
+  vector<vector<Arc>> adjacency(n);
+  for (uint32_t v = 0; v < n; ++v) {
+    vector<Arc>& arcs = adjacency[v];
+    arcs.reserve(g.degree(v));
+
+    for (uint64_t i = g.offset(v); i < g.offset(v + 1); ++i) {
+      if (g.neighbor(i) != v) arcs.push_back({g.neighbor(i), NO_VERTEX, g.weight(i)});
+    }
+
+    std::sort(arcs.begin(), arcs.end(), [](const Arc& a, const Arc& b) {
+      return a.target != b.target ? a.target < b.target : a.weight < b.weight;
+    });
+    arcs.erase(std::unique(arcs.begin(), arcs.end(),
+      [](const Arc& a, const Arc& b) { return a.target == b.target; }
+    ), arcs.end());
+  }
+
+  ThreadPool pool(std::max(num_threads, 1));
+  vector<unique_ptr<WitnessSearch>> searches(pool.size());
+  vector<vector<Shortcut>> scratch(pool.size());
+
+  auto search_for = [&](int thread) -> WitnessSearch& {
+    if (!searches[thread]) searches[thread].reset(new WitnessSearch(n));
+    return *searches[thread];
+  };
+
+  // vertices being contracted in the current round, which witness paths must
+  // avoid, since they disappear together
+  vector<uint8_t> contracting(n, 0);
+  vector<uint32_t> contracted_neighbors(n, 0);
+  vector<int64_t> priority(n);
+
+  auto update_priority = [&](uint32_t v, int thread) {
+    if (adjacency[v].size() > MAX_CONTRACTED_DEGREE) {
+      priority[v] = CORE;
+      return;
+    }
+
+    find_shortcuts(adjacency, v, contracting, search_for(thread),
+                   scratch[thread]);
+    priority[v] = static_cast<int64_t>(scratch[thread].size())
+      - static_cast<int64_t>(adjacency[v].size()) + contracted_neighbors[v];
+  };
+
+  pool.parallelFor(n, [&](size_t v, int thread) { update_priority(v, thread); });
+
+  ContractionHierarchy hierarchy;
+  hierarchy.rank_.resize(n);
+  vector<vector<Arc>> upward(n);
+  vector<uint32_t> remaining(n);
+  for (uint32_t v = 0; v < n; ++v) remaining[v] = v;
+
+  uint32_t next_rank = 0;
+  vector<uint8_t> touched(n, 0);
+
+  while (!remaining.empty()) {
+    // a vertex is contracted this round if it comes before all of its
+    // neighbors, so no two vertices of a round are adjacent
+    pool.parallelFor(remaining.size(), [&](size_t i, int) {
+      uint32_t v = remaining[i];
+      bool first = priority[v] != CORE;
+
+      for (const Arc& arc : adjacency[v]) {
+        uint32_t u = arc.target;
+        if (priority[u] < priority[v] || (priority[u] == priority[v] && u < v)) {
+          first = false;
+          break;
+        }
+      }
+
+      contracting[v] = first;
+    });
+
+    vector<uint32_t> round;
+    vector<uint32_t> next_remaining;
+    for (uint32_t v : remaining) {
+      (contracting[v] ? round : next_remaining).push_back(v);
+    }
+    remaining.swap(next_remaining);
+
+    // only the core is left
+    if (round.empty()) break;
+
+    vector<vector<Shortcut>> shortcuts(round.size());
+    pool.parallelFor(round.size(), [&](size_t i, int thread) {
+      find_shortcuts(adjacency, round[i], contracting, search_for(thread),
+                     shortcuts[i]);
+    });
+
+    // remove the round from the graph and add its shortcuts
+    vector<uint32_t> neighbors;
+    for (size_t i = 0; i < round.size(); ++i) {
+      uint32_t v = round[i];
+      hierarchy.rank_[v] = next_rank++;
+
+      for (const Arc& arc : adjacency[v]) {
+        remove_arc(adjacency[arc.target], v);
+        ++contracted_neighbors[arc.target];
+
+        if (!touched[arc.target]) {
+          touched[arc.target] = 1;
+          neighbors.push_back(arc.target);
+        }
+      }
+
+      for (const Shortcut& shortcut : shortcuts[i]) {
+        add_arc(adjacency[shortcut.from], {shortcut.to, v, shortcut.weight});
+        add_arc(adjacency[shortcut.to], {shortcut.from, v, shortcut.weight});
+      }
+
+      // every remaining neighbor is contracted in a later round or is part
+      // of the core
+      upward[v].swap(adjacency[v]);
+      contracting[v] = 0;
+    }
+
+    pool.parallelFor(neighbors.size(), [&](size_t i, int thread) {
+      update_priority(neighbors[i], thread);
+    });
+
+    for (uint32_t v : neighbors) touched[v] = 0;
+  }
+
+  // the core ranks above every contracted vertex, and its edges are kept in
+  // both directions, so queries run plain Dijkstra's algorithm within it
+  for (uint32_t v : remaining) {
+    hierarchy.rank_[v] = next_rank++;
+    upward[v].swap(adjacency[v]);
+  }
+
+  hierarchy.up_offsets_.resize(n + 1);
+  for (uint32_t v = 0; v < n; ++v) {
+    hierarchy.up_offsets_[v + 1] = hierarchy.up_offsets_[v] + upward[v].size();
+  }
+
+  uint64_t num_up_edges = hierarchy.up_offsets_[n];
+  hierarchy.up_targets_.reserve(num_up_edges);
+  hierarchy.up_middles_.reserve(num_up_edges);
+  hierarchy.up_weights_.reserve(num_up_edges);
+
+  for (uint32_t v = 0; v < n; ++v) {
+    for (const Arc& arc : upward[v]) {
+      hierarchy.up_targets_.push_back(arc.target);
+      hierarchy.up_middles_.push_back(arc.middle);
+      hierarchy.up_weights_.push_back(arc.weight);
+    }
+
+    vector<Arc>().swap(upward[v]);
+  }
+
+  return hierarchy;
+}
+
+bool ContractionHierarchy::save(const string& path, const CSRGraph& g) const {
+  ofstream of(path, std::ios::binary | std::ios::trunc);
+  if (!of.is_open()) return false;
+
+  HierarchyHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, HIERARCHY_MAGIC, sizeof(header.magic));
+  header.version = HIERARCHY_VERSION;
+  header.header_size = sizeof(HierarchyHeader);
+  header.num_vertices = g.numVertices();
+  header.num_edges = g.numEdges();
+  header.fingerprint = graph_fingerprint(g);
+  header.num_up_edges = up_targets_.size();
+
+  of.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  snapshot_write_array(of, rank_);
+  snapshot_write_array(of, up_offsets_);
+  snapshot_write_array(of, up_targets_);
+  snapshot_write_array(of, up_middles_);
+  snapshot_write_array(of, up_weights_);
+
+  return of.good();
+}
+
+bool ContractionHierarchy::load(const string& path, const CSRGraph& g,
+                                ContractionHierarchy& hierarchy) {
+  MappedFile file(path);
+  if (!file.isOpen() || file.size() < sizeof(HierarchyHeader)) return false;
+
+  const HierarchyHeader* header =
+    reinterpret_cast<const HierarchyHeader*>(file.data());
+
+  if (memcmp(header->magic, HIERARCHY_MAGIC, sizeof(header->magic)) != 0
+      || header->version != HIERARCHY_VERSION
+      || header->num_vertices != g.numVertices()
+      || header->num_edges != g.numEdges()
+      || header->fingerprint != graph_fingerprint(g)
+      || header->header_size < sizeof(HierarchyHeader)
+      || header->header_size % 8 != 0) {
+    return false;
+  }
+
+  size_t n = header->num_vertices;
+  size_t m = header->num_up_edges;
+  size_t offset = header->header_size;
+  const uint32_t* rank;
+  const uint64_t* up_offsets;
+  const uint32_t* up_targets;
+  const uint32_t* up_middles;
+  const uint64_t* up_weights;
+
+  bool complete = snapshot_read_array(file, offset, n, rank)
+    && snapshot_read_array(file, offset, n + 1, up_offsets)
+    && snapshot_read_array(file, offset, m, up_targets)
+    && snapshot_read_array(file, offset, m, up_middles)
+    && snapshot_read_array(file, offset, m, up_weights);
+  if (!complete || up_offsets[0] != 0 || up_offsets[n] != m) return false;
+
+  // a corrupt file must not send a query outside of the arrays
+  for (size_t v = 0; v < n; ++v) {
+    if (rank[v] >= n || up_offsets[v] > up_offsets[v + 1]) return false;
+  }
+
+  // unpacking a shortcut only ends if its middle ranks below both endpoints,
+  // so each step descends the hierarchy
+  for (size_t v = 0; v < n; ++v) {
+    for (uint64_t i = up_offsets[v]; i < up_offsets[v + 1]; ++i) {
+      uint32_t target = up_targets[i];
+      uint32_t middle = up_middles[i];
+      if (target >= n) return false;
+      if (middle == NO_VERTEX) continue;
+      if (middle >= n || rank[middle] >= rank[v]
+          || rank[middle] >= rank[target]) {
+        return false;
+      }
+    }
+  }
+
+  hierarchy.rank_.assign(rank, rank + n);
+  hierarchy.up_offsets_.assign(up_offsets, up_offsets + n + 1);
+  hierarchy.up_targets_.assign(up_targets, up_targets + m);
+  hierarchy.up_middles_.assign(up_middles, up_middles + m);
+  hierarchy.up_weights_.assign(up_weights, up_weights + m);
+  return true;
+}
+
+uint64_t ContractionHierarchy::numShortcuts() const {
+  return std::count_if(up_middles_.begin(), up_middles_.end(),
+    [](uint32_t middle) { return middle != NO_VERTEX; }
+  );
+}
+
+void ContractionHierarchy::advance(TraversalWorkspace& self,
+                                   const TraversalWorkspace& other,
+                                   uint64_t& best, uint32_t& meet) const {
+  IndexedHeap& q = self.getHeap();
+  uint64_t distance = q.top().first;
+  uint32_t u = q.top().second;
+  q.pop();
+  self.settle(u);
+
+  uint64_t other_distance = other.getDistance(u);
+  if (other_distance != UNREACHED && distance + other_distance < best) {
+    best = distance + other_distance;
+    meet = u;
+  }
+
+  // a higher ranked vertex that reaches u on a shorter path means no shortest
+  // path climbs through u
+  for (uint64_t i = up_offsets_[u]; i < up_offsets_[u + 1]; ++i) {
+    uint64_t above = self.getDistance(up_targets_[i]);
+    if (above != UNREACHED && above + up_weights_[i] < distance) return;
+  }
+
+  for (uint64_t i = up_offsets_[u]; i < up_offsets_[u + 1]; ++i) {
+    uint32_t v = up_targets_[i];
+    uint64_t temp_dist = distance + up_weights_[i];
+
+    if (temp_dist < self.getDistance(v)) {
+      self.setDistance(v, temp_dist);
+      self.setParent(v, u);
+      q.pushOrDecrease(v, temp_dist);
+    }
+  }
+}
+
+void ContractionHierarchy::unpack(uint32_t a, uint32_t b,
+                                  vector<uint32_t>& path) const {
+  // edges left to unpack, the next one on the path last
+  vector<pair<uint32_t, uint32_t>> stack = {{a, b}};
+
+  while (!stack.empty()) {
+    uint32_t from = stack.back().first;
+    uint32_t to = stack.back().second;
+    stack.pop_back();
+
+    // the edge is stored with its lower ranked endpoint
+    uint32_t low = rank_[from] < rank_[to] ? from : to;
+    uint32_t high = low == from ? to : from;
+    uint32_t middle = NO_VERTEX;
+
+    for (uint64_t i = up_offsets_[low]; i < up_offsets_[low + 1]; ++i) {
+      if (up_targets_[i] == high) {
+        middle = up_middles_[i];
+        break;
+      }
+    }
+
+    if (middle == NO_VERTEX) {
+      path.push_back(from);
+    } else {
+      stack.push_back({middle, to});
+      stack.push_back({from, middle});
+    }
+  }
+}
+
+ShortestPath ContractionHierarchy::query(uint32_t source, uint32_t target,
+                                         TraversalWorkspace& forward,
+                                         TraversalWorkspace& backward) const {
+  ShortestPath result = {UNREACHED, {}, 0};
+  forward.reset();
+  backward.reset();
+
+  IndexedHeap& forward_q = forward.getHeap();
+  IndexedHeap& backward_q = backward.getHeap();
+  forward_q.clear();
+  backward_q.clear();
+
+  forward.setDistance(source, 0);
+  forward_q.pushOrDecrease(source, 0);
+  backward.setDistance(target, 0);
+  backward_q.pushOrDecrease(target, 0);
+
+  uint64_t best = UNREACHED;
+  uint32_t meet = NO_VERTEX;
+
+  // unlike plain bidirectional search, each direction runs until its closest
+  // vertex is no closer than the best path, since the searches only meet at
+  // the highest ranked vertex of the path
+  while (true) {
+    bool forward_open = !forward_q.empty() && forward_q.top().first < best;
+    bool backward_open = !backward_q.empty() && backward_q.top().first < best;
+    if (!forward_open && !backward_open) break;
+
+    if (forward_open && (!backward_open ||
+        forward_q.top().first <= backward_q.top().first)) {
+      advance(forward, backward, best, meet);
+    } else {
+      advance(backward, forward, best, meet);
+    }
+  }
+
+  forward_q.clear();
+  backward_q.clear();
+
+  result.settled = forward.getSettledOrder().size()
+    + backward.getSettledOrder().size();
+  if (meet == NO_VERTEX) return result;
+
+  result.distance = best;
+
+  // climb from the source to the meeting vertex, then descend to the target
+  vector<uint32_t> climb;
+  for (uint32_t v = meet; v != NO_VERTEX; v = forward.getParent(v)) {
+    climb.push_back(v);
+  }
+  std::reverse(climb.begin(), climb.end());
+
+  for (size_t i = 0; i + 1 < climb.size(); ++i) {
+    unpack(climb[i], climb[i + 1], result.path);
+  }
+
+  for (uint32_t v = meet; v != target; v = backward.getParent(v)) {
+    unpack(v, backward.getParent(v), result.path);
+  }
+  result.path.push_back(target);
+
+  return result;
+}
@@ -0,0 +1,172 @@
+#include "algorithms/delta_stepping.h"
+#include "algorithms/workspace.h"
+
+#include <algorithm>
+#include <atomic>
+#include <map>
+
+using std::atomic;
+using std::vector;
+using std::pair;
+using std::map;
+
+/**
+ * @brief The number of vertices of a bucket each parallel task relaxes.
+ */
+static const size_t VERTICES_PER_TASK = 256;
+
+uint64_t default_delta(const CSRGraph& g) {
+  uint64_t num_entries = g.offset(g.numVertices());
+  if (num_entries == 0) return 1;
+
+  // sum in long double since the total gas of a large graph can overflow
+  long double total = 0;
+  for (uint64_t i = 0; i < num_entries; ++i) total += g.weight(i);
+
+  return static_cast<uint64_t>(total / num_entries) + 1;
+}
+
+/**
+ * @brief The shared state of a single delta-stepping search.
+ */
+struct DeltaSteppingState {
+  DeltaSteppingState(const CSRGraph& graph, uint64_t width, int num_threads)
+    : g(graph), delta(width), distance(graph.numVertices()), 
+      moved(num_threads), removed(num_threads) {
+    for (atomic<uint64_t>& d : distance) {
+      d.store(TraversalWorkspace::UNREACHED, std::memory_order_relaxed);
+    }
+  }
+
+  const CSRGraph& g;
+  uint64_t delta;
+
+  /**
+   * @brief The tentative distance to each vertex.
+   */
+  vector<atomic<uint64_t>> distance;
+
+  /**
+   * @brief Per-thread buffers of (bucket, vertex) pairs for vertices whose
+   * distance was lowered in the current phase.
+   */
+  vector<vector<pair<uint64_t, uint32_t>>> moved;
+
+  /**
+   * @brief Per-thread buffers of vertices removed from the current bucket,
+   * whose heavy edges still need to be relaxed.
+   */
+  vector<vector<uint32_t>> removed;
+
+  /**
+   * @brief Lower the distance to v to the passed distance if it is shorter,
+   * recording the move in the buffer of the passed thread.
+   */
+  void relax(uint32_t v, uint64_t new_distance, int thread) {
+    uint64_t old_distance = distance[v].load(std::memory_order_relaxed);
+
+    while (new_distance < old_distance) {
+      if (distance[v].compare_exchange_weak(old_distance, new_distance,
+                                            std::memory_order_relaxed)) {
+        moved[thread].push_back({new_distance / delta, v});
+        return;
+      }
+    }
+  }
+
+  /**
+   * @brief Relax either the light or the heavy edges of u.
+   */
+  void relaxEdges(uint32_t u, bool light, int thread) {
+    uint64_t du = distance[u].load(std::memory_order_relaxed);
+
+    for (uint64_t i = g.offset(u); i < g.offset(u + 1); ++i) {
+      if ((g.weight(i) <= delta) == light) {
+        relax(g.neighbor(i), du + g.weight(i), thread);
+      }
+    }
+  }
+};
+
+vector<uint64_t> delta_stepping(const CSRGraph& g, uint32_t start, 
+                                uint64_t delta, ThreadPool& pool) {
+  if (delta == 0) delta = default_delta(g);
+
+  DeltaSteppingState state(g, delta, pool.size());
+  map<uint64_t, vector<uint32_t>> buckets;
+
+  // the bucket each vertex was last removed from, plus one, so that heavy 
+  // edges are relaxed once per bucket even if a vertex was removed repeatedly
+  vector<uint64_t> removed_from(g.numVertices(), 0);
+
+  state.distance[start].store(0);
+  buckets[0].push_back(start);
+
+  // move every vertex whose distance was lowered into its new bucket
+  auto merge_moved = [&]() {
+    for (vector<pair<uint64_t, uint32_t>>& buffer : state.moved) {
+      for (const pair<uint64_t, uint32_t>& entry : buffer) {
+        buckets[entry.first].push_back(entry.second);
+      }
+
+      buffer.clear();
+    }
+  };
+
+  while (!buckets.empty()) {
+    uint64_t index = buckets.begin()->first;
+    vector<uint32_t> heavy;
+
+    // relax light edges until the bucket stays empty
+    while (buckets.count(index) != 0) {
+      vector<uint32_t> frontier = std::move(buckets[index]);
+      buckets.erase(index);
+
+      pool.parallelForRange(frontier.size(), VERTICES_PER_TASK,
+                            [&](size_t begin, size_t end, int thread) {
+        for (size_t i = begin; i < end; ++i) {
+          uint32_t u = frontier[i];
+
+          // skip vertices that were moved to an earlier bucket after being
+          // added to this one
+          if (state.distance[u].load(std::memory_order_relaxed) / delta 
+              != index) {
+            continue;
+          }
+
+          state.relaxEdges(u, true, thread);
+          state.removed[thread].push_back(u);
+        }
+      });
+
+      for (vector<uint32_t>& buffer : state.removed) {
+        for (uint32_t u : buffer) {
+          if (removed_from[u] == index + 1) continue;
+          removed_from[u] = index + 1;
+          heavy.push_back(u);
+        }
+
+        buffer.clear();
+      }
+
+      merge_moved();
+    }
+
+    // heavy edges always lead past the current bucket, so relax them once
+    pool.parallelForRange(heavy.size(), VERTICES_PER_TASK,
+                          [&](size_t begin, size_t end, int thread) {
+      for (size_t i = begin; i < end; ++i) {
+        state.relaxEdges(heavy[i], false, thread);
+      }
+    });
+
+    merge_moved();
+  }
+
+  vector<uint64_t> distances(g.numVertices());
+  for (uint32_t v = 0; v < g.numVertices(); ++v) {
+    distances[v] = state.distance[v].load(std::memory_order_relaxed);
+  }
+
+  return distances;
+}
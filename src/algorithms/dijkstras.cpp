@@ -4,37 +4,35 @@
 #include <queue>
 
 using std::priority_queue;
+using std::greater;
 using std::unordered_map;
 using std::vector;
-using std::string;
-using std::stack;
+using std::pair;
 
 void dijkstra(Graph* g, Vertex* start) {
-  // creates a priority queue based on distance of vertices
-  priority_queue<Vertex*, vector<Vertex*>, VertexPointerComparator> q; 
+  // creates a priority queue of (distance, vertex) pairs ordered by smallest
+  // distance first. The distance is copied into each entry when it is pushed, 
+  // because changing a key that is already in the queue would break the order
+  // of the queue.
+  priority_queue<pair<uint64_t, Vertex*>, vector<pair<uint64_t, Vertex*>>, 
+                 greater<pair<uint64_t, Vertex*>>> q; 
 
-  g->resetDistanceOrderedVertices();
   for (auto vertex : g->getVertices()) {
     vertex.second->reset();
   }
 
-  start->incrementCentrality(1.0);
   start->setDistance(0);
-  q.push(start);
+  q.push({0, start});
 
   uint64_t temp_dist;
 
   while (!q.empty()) {
-    Vertex* U = q.top(); // vertex marked with shortest distance rn
-    while (U->wasExplored()) {
-      if (q.empty()) return; // error checking
-      q.pop(); 
-      U = q.top(); // keep going until we find vertex we haven't marked as visited (bc we constantly repush verteces to keep the queue updated)
-    }
+    Vertex* U = q.top().second; // vertex marked with shortest distance rn
+    q.pop();
 
-    g->pushDistanceOrderedVertex(U);
+    // skip stale entries (bc we constantly repush verteces to keep the queue updated)
+    if (U->wasExplored()) continue;
     U->setExplored(true); // after with this iteration, this will have been explored
-    q.pop();
 
     for (auto incident_edge : U->getIncidentEdges()) {
       Vertex* V = incident_edge->getAdjacentVertex(U); // for every adjacent vertex to this one
@@ -44,13 +42,176 @@ void dijkstra(Graph* g, Vertex* start) {
         if (temp_dist <= V->getDistance()) { // found a new shortest path, bc this path shorter than other distance
           V->setDistance(temp_dist); // relax the vertex distance
           V->setParent(U); //record that the parent for this adjacent vertex is us
-          q.push(V); // to reorder the priority queue with this new weighting
-
-          // Betweenness Centrality calculations
-          V->incrementCentrality(U->getCentrality());
-          V->addCentralityParent(U);
+          q.push({temp_dist, V}); // to reorder the priority queue with this new weighting
         }
       }
     }
   }
 }
+
+
+/**
+ * @brief Adapts std::priority_queue to the interface of IndexedHeap. Every
+ * improvement pushes a new entry and the old entries are left in the queue, so
+ * callers must skip vertices that were already settled when they are popped.
+ */
+class LazyBinaryHeap {
+  public:
+    bool empty() const { return q_.empty(); }
+    const pair<uint64_t, uint32_t>& top() const { return q_.top(); }
+    void pushOrDecrease(uint32_t v, uint64_t distance) { q_.push({distance, v}); }
+    void pop() { q_.pop(); }
+    void clear() { q_ = {}; }
+  private:
+    // (distance, vertex) pairs ordered by smallest distance first
+    priority_queue<pair<uint64_t, uint32_t>, vector<pair<uint64_t, uint32_t>>, 
+                   greater<pair<uint64_t, uint32_t>>> q_;
+};
+
+/**
+ * @brief Run Dijkstra's algorithm on a CSRGraph using the passed queue. Refer 
+ * to the declaration of dijkstra in dijkstras.h.
+ */
+template <typename Queue>
+static void dijkstra_with_queue(const CSRGraph& g, const uint32_t* starts,
+                                size_t num_starts, 
+                                TraversalWorkspace& workspace, Queue& q,
+                                const SearchLimits& limits) {
+  workspace.reset();
+
+  // duplicate targets are only counted once
+  size_t targets_left = 0;
+  for (uint32_t target : limits.targets) {
+    if (!workspace.isTarget(target)) {
+      workspace.markTarget(target);
+      ++targets_left;
+    }
+  }
+
+  q.clear();
+
+  for (size_t i = 0; i < num_starts; ++i) {
+    workspace.setDistance(starts[i], 0);
+    workspace.setPathCount(starts[i], 1.0);
+    q.pushOrDecrease(starts[i], 0);
+  }
+
+  while (!q.empty()) {
+    uint64_t distance = q.top().first;
+    uint32_t u = q.top().second;
+    q.pop();
+
+    // skip stale entries left behind by queues without decrease-key
+    if (workspace.wasExplored(u)) continue;
+
+    if (distance > limits.max_distance || 
+        workspace.getSettledOrder().size() >= limits.max_settled) {
+      break;
+    }
+
+    workspace.settle(u);
+
+    for (uint64_t i = g.offset(u); i < g.offset(u + 1); ++i) {
+      uint32_t v = g.neighbor(i);
+      if (workspace.wasExplored(v)) continue;
+
+      uint64_t temp_dist = distance + g.weight(i);
+
+      if (temp_dist < workspace.getDistance(v)) {
+        // found a strictly shorter path, so every earlier path is discarded
+        workspace.setDistance(v, temp_dist);
+        workspace.setParent(v, u);
+        workspace.setPathCount(v, workspace.getPathCount(u));
+        workspace.clearPredecessors(v);
+        workspace.addPredecessor(v, u);
+        q.pushOrDecrease(v, temp_dist);
+      } else if (temp_dist == workspace.getDistance(v)) {
+        // found another shortest path of the same length
+        workspace.setParent(v, u);
+        workspace.setPathCount(
+          v, workspace.getPathCount(v) + workspace.getPathCount(u)
+        );
+        workspace.addPredecessor(v, u);
+      }
+    }
+
+    if (workspace.isTarget(u) && --targets_left == 0) break;
+  }
+
+  // a search that stopped early leaves entries behind
+  q.clear();
+}
+
+void dijkstra(const CSRGraph& g, uint32_t start, TraversalWorkspace& workspace,
+              QueueType queue) {
+  static const SearchLimits unlimited;
+  bounded_dijkstra(g, start, workspace, unlimited, queue);
+}
+
+/**
+ * @brief Run Dijkstra's algorithm on a CSRGraph from every passed start vertex
+ * at once with the passed queue type.
+ */
+static void dijkstra_from(const CSRGraph& g, const uint32_t* starts,
+                          size_t num_starts, TraversalWorkspace& workspace,
+                          const SearchLimits& limits, QueueType queue) {
+  if (queue == QueueType::AUTO || queue == QueueType::BUCKET_QUEUE) {
+    queue = g.maxWeight() <= BucketQueue::MAX_WEIGHT 
+      ? QueueType::BUCKET_QUEUE : QueueType::RADIX_HEAP;
+  }
+
+  if (queue == QueueType::LAZY_BINARY_HEAP) {
+    LazyBinaryHeap q;
+    dijkstra_with_queue(g, starts, num_starts, workspace, q, limits);
+  } else if (queue == QueueType::INDEXED_HEAP) {
+    dijkstra_with_queue(g, starts, num_starts, workspace, 
+                        workspace.getHeap(), limits);
+  } else if (queue == QueueType::RADIX_HEAP) {
+    dijkstra_with_queue(g, starts, num_starts, workspace, 
+                        workspace.getRadixHeap(), limits);
+  } else {
+    dijkstra_with_queue(g, starts, num_starts, workspace, 
+                        workspace.getBucketQueue(g.maxWeight()), limits);
+  }
+}
+
+void bounded_dijkstra(const CSRGraph& g, uint32_t start, 
+                      TraversalWorkspace& workspace, const SearchLimits& limits,
+                      QueueType queue) {
+  dijkstra_from(g, &start, 1, workspace, limits, queue);
+}
+
+void multi_source_dijkstra(const CSRGraph& g, const vector<uint32_t>& sources,
+                           TraversalWorkspace& workspace,
+                           vector<uint32_t>& nearest_source,
+                           const SearchLimits& limits, QueueType queue) {
+  dijkstra_from(g, sources.data(), sources.size(), workspace, limits, queue);
+
+  // parents are settled before their children, so the closest source of
+  // every vertex is known by the time it is reached in settle order
+  nearest_source.assign(g.numVertices(), TraversalWorkspace::NO_VERTEX);
+
+  for (uint32_t v : workspace.getSettledOrder()) {
+    uint32_t parent = workspace.getParent(v);
+    nearest_source[v] = parent == TraversalWorkspace::NO_VERTEX 
+      ? v : nearest_source[parent];
+  }
+}
+
+bool parse_queue_type(const std::string& name, QueueType& queue) {
+  if (name == "lazy") {
+    queue = QueueType::LAZY_BINARY_HEAP;
+  } else if (name == "heap") {
+    queue = QueueType::INDEXED_HEAP;
+  } else if (name == "radix") {
+    queue = QueueType::RADIX_HEAP;
+  } else if (name == "dial") {
+    queue = QueueType::BUCKET_QUEUE;
+  } else if (name == "auto") {
+    queue = QueueType::AUTO;
+  } else {
+    return false;
+  }
+
+  return true;
+}
@@ -0,0 +1,175 @@
+#include "algorithms/hop_labels.h"
+#include "utils/thread_pool.h"
+
+#include <algorithm>
+#include <memory>
+
+using std::unique_ptr;
+using std::vector;
+using std::pair;
+
+static const uint32_t UNREACHED = HopLabeling::UNREACHED;
+
+namespace {
+
+/**
+ * @brief The scratch space of a single pruned breadth first search. Each
+ * thread owns one, and every array is restored to UNREACHED after a search,
+ * so a search only pays for the vertices it reaches.
+ */
+struct LabelSearch {
+  explicit LabelSearch(uint32_t size)
+    : distances(size, UNREACHED), root_label(size, UNREACHED), queue() { }
+
+  /**
+   * @brief The hop distance of every vertex from the root of the search.
+   */
+  vector<uint32_t> distances;
+
+  /**
+   * @brief The label of the root, indexed by hub.
+   */
+  vector<uint32_t> root_label;
+
+  /**
+   * @brief The vertices reached by the search, in the order they were 
+   * reached.
+   */
+  vector<uint32_t> queue;
+};
+
+} // namespace
+
+/**
+ * @brief Run a pruned breadth first search from the hub at the passed 
+ * position of the order, and collect the (vertex, distance) pairs whose labels
+ * the hub must be added to. Only the labels passed in are used to prune, and
+ * they are not modified.
+ */
+static void search_from_hub(const CSRGraph& g, 
+                            const vector<vector<HopLabeling::LabelEntry>>& labels,
+                            uint32_t root, LabelSearch& search,
+                            vector<pair<uint32_t, uint32_t>>& reached) {
+  reached.clear();
+
+  for (const HopLabeling::LabelEntry& entry : labels[root]) {
+    search.root_label[entry.hub] = entry.distance;
+  }
+
+  search.queue.clear();
+  search.queue.push_back(root);
+  search.distances[root] = 0;
+
+  for (size_t head = 0; head < search.queue.size(); ++head) {
+    uint32_t u = search.queue[head];
+    uint32_t distance = search.distances[u];
+
+    // a hub of an earlier search already lies on a shortest path to u
+    bool covered = false;
+    for (const HopLabeling::LabelEntry& entry : labels[u]) {
+      uint32_t to_root = search.root_label[entry.hub];
+      if (to_root != UNREACHED && to_root + entry.distance <= distance) {
+        covered = true;
+        break;
+      }
+    }
+
+    if (covered) continue;
+    reached.push_back({u, distance});
+
+    for (uint64_t i = g.offset(u); i < g.offset(u + 1); ++i) {
+      uint32_t v = g.neighbor(i);
+
+      if (search.distances[v] == UNREACHED) {
+        search.distances[v] = distance + 1;
+        search.queue.push_back(v);
+      }
+    }
+  }
+
+  for (uint32_t v : search.queue) search.distances[v] = UNREACHED;
+  for (const HopLabeling::LabelEntry& entry : labels[root]) {
+    search.root_label[entry.hub] = UNREACHED;
+  }
+}
+
+HopLabeling::HopLabeling() : order_(), offsets_(1, 0), entries_() { }
+
+HopLabeling HopLabeling::build(const CSRGraph& g, int num_threads) {
+  uint32_t n = g.numVertices();
+  HopLabeling labeling;
+
+  // hubs in order of decreasing degree, ties broken by the lower ID
+  labeling.order_.resize(n);
+  for (uint32_t v = 0; v < n; ++v) labeling.order_[v] = v;
+
+  std::sort(labeling.order_.begin(), labeling.order_.end(),
+    [&g](uint32_t a, uint32_t b) {
+      return g.degree(a) != g.degree(b) ? g.degree(a) > g.degree(b) : a < b;
+    }
+  );
+
+  ThreadPool pool(std::max(num_threads, 1));
+  vector<unique_ptr<LabelSearch>> searches(pool.size());
+  vector<vector<pair<uint32_t, uint32_t>>> reached(pool.size());
+  vector<vector<LabelEntry>> labels(n);
+
+  for (uint32_t first = 0; first < n; first += pool.size()) {
+    uint32_t batch = std::min<uint32_t>(pool.size(), n - first);
+
+    pool.parallelFor(batch, [&](size_t i, int) {
+      // each search of a batch has its own buffers, so the labels of the
+      // batch can be added in hub order afterwards
+      if (!searches[i]) searches[i].reset(new LabelSearch(n));
+      search_from_hub(g, labels, labeling.order_[first + i], *searches[i],
+                      reached[i]);
+    });
+
+    for (uint32_t i = 0; i < batch; ++i) {
+      for (const pair<uint32_t, uint32_t>& entry : reached[i]) {
+        labels[entry.first].push_back({first + i, entry.second});
+      }
+    }
+  }
+
+  labeling.offsets_.resize(n + 1);
+  for (uint32_t v = 0; v < n; ++v) {
+    labeling.offsets_[v + 1] = labeling.offsets_[v] + labels[v].size();
+  }
+
+  labeling.entries_.reserve(labeling.offsets_[n]);
+  for (uint32_t v = 0; v < n; ++v) {
+    labeling.entries_.insert(labeling.entries_.end(), labels[v].begin(), 
+                             labels[v].end());
+    vector<LabelEntry>().swap(labels[v]);
+  }
+
+  return labeling;
+}
+
+uint32_t HopLabeling::query(uint32_t u, uint32_t v) const {
+  const LabelEntry* a = entries_.data() + offsets_[u];
+  const LabelEntry* a_end = entries_.data() + offsets_[u + 1];
+  const LabelEntry* b = entries_.data() + offsets_[v];
+  const LabelEntry* b_end = entries_.data() + offsets_[v + 1];
+  uint32_t best = UNREACHED;
+
+  while (a != a_end && b != b_end) {
+    if (a->hub < b->hub) {
+      ++a;
+    } else if (b->hub < a->hub) {
+      ++b;
+    } else {
+      best = std::min(best, a->distance + b->distance);
+      ++a;
+      ++b;
+    }
+  }
+
+  return best;
+}
+
+uint64_t HopLabeling::memoryUsage() const {
+  return order_.size() * sizeof(uint32_t) + offsets_.size() * sizeof(uint64_t)
+    + entries_.size() * sizeof(LabelEntry);
+}
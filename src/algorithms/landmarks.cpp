@@ -0,0 +1,198 @@
+#include "algorithms/landmarks.h"
+#include "algorithms/dijkstras.h"
+#include "utils/thread_pool.h"
+#include "core/snapshot.h"
+
+#include <algorithm>
+#include <cstring>
+#include <memory>
+
+using std::unique_ptr;
+using std::ofstream;
+using std::string;
+using std::vector;
+
+static const uint64_t UNREACHED = TraversalWorkspace::UNREACHED;
+
+LandmarkIndex::LandmarkIndex() : landmarks_(), distances_() { }
+
+LandmarkIndex LandmarkIndex::build(const CSRGraph& g, int num_landmarks, 
+                                   int num_threads) {
+  LandmarkIndex index;
+  uint32_t k = std::min<uint32_t>(std::max(num_landmarks, 0), g.numVertices());
+
+  // the k vertices of highest degree, ties broken by the lower ID
+  vector<uint32_t> by_degree(g.numVertices());
+  for (uint32_t v = 0; v < g.numVertices(); ++v) by_degree[v] = v;
+
+  std::partial_sort(by_degree.begin(), by_degree.begin() + k, by_degree.end(),
+    [&g](uint32_t a, uint32_t b) {
+      return g.degree(a) != g.degree(b) ? g.degree(a) > g.degree(b) : a < b;
+    }
+  );
+
+  index.landmarks_.assign(by_degree.begin(), by_degree.begin() + k);
+  index.distances_.resize(static_cast<uint64_t>(g.numVertices()) * k);
+
+  // each thread searches from whichever landmark is next with its own 
+  // workspace, which is only allocated once the thread takes a landmark
+  ThreadPool pool(std::min<int>(std::max(num_threads, 1), std::max(k, 1u)));
+  vector<unique_ptr<TraversalWorkspace>> workspaces(pool.size());
+
+  pool.parallelFor(k, [&](size_t i, int thread) {
+    if (!workspaces[thread]) {
+      workspaces[thread].reset(new TraversalWorkspace(g));
+    }
+
+    TraversalWorkspace& workspace = *workspaces[thread];
+    dijkstra(g, index.landmarks_[i], workspace);
+
+    for (uint32_t v = 0; v < g.numVertices(); ++v) {
+      index.distances_[static_cast<uint64_t>(v) * k + i] = 
+        workspace.getDistance(v);
+    }
+  });
+
+  return index;
+}
+
+bool LandmarkIndex::save(const string& path, const CSRGraph& g) const {
+  ofstream of(path, std::ios::binary | std::ios::trunc);
+  if (!of.is_open()) return false;
+
+  vector<uint8_t> addresses;
+  addresses.reserve(landmarks_.size() * Address::SIZE);
+  for (uint32_t landmark : landmarks_) {
+    const uint8_t* address = g.getAddress(landmark).data();
+    addresses.insert(addresses.end(), address, address + Address::SIZE);
+  }
+
+  LandmarkHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, LANDMARK_MAGIC, sizeof(header.magic));
+  header.version = LANDMARK_VERSION;
+  header.header_size = sizeof(LandmarkHeader);
+  header.num_vertices = g.numVertices();
+  header.num_edges = g.numEdges();
+  header.num_landmarks = landmarks_.size();
+
+  of.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  snapshot_write_array(of, addresses);
+  snapshot_write_array(of, landmarks_);
+  snapshot_write_array(of, distances_);
+
+  return of.good();
+}
+
+bool LandmarkIndex::load(const string& path, const CSRGraph& g,
+                         LandmarkIndex& index) {
+  MappedFile file(path);
+  if (!file.isOpen() || file.size() < sizeof(LandmarkHeader)) return false;
+
+  const LandmarkHeader* header = 
+    reinterpret_cast<const LandmarkHeader*>(file.data());
+
+  if (memcmp(header->magic, LANDMARK_MAGIC, sizeof(header->magic)) != 0
+      || header->version != LANDMARK_VERSION
+      || header->num_vertices != g.numVertices()
+      || header->num_edges != g.numEdges()
+      || header->num_landmarks > g.numVertices()
+      || header->header_size < sizeof(LandmarkHeader)
+      || header->header_size % 8 != 0) {
+    return false;
+  }
+
+  size_t k = header->num_landmarks;
+  size_t offset = header->header_size;
+  const uint8_t* addresses;
+  const uint32_t* landmarks;
+  const uint64_t* distances;
+
+  bool complete = 
+    snapshot_read_array(file, offset, k * Address::SIZE, addresses)
+    && snapshot_read_array(file, offset, k, landmarks)
+    && snapshot_read_array(file, offset, g.numVertices() * k, distances);
+  if (!complete) return false;
+
+  // the landmarks must be the same addresses in the passed graph
+  for (size_t i = 0; i < k; ++i) {
+    if (landmarks[i] >= g.numVertices() || g.getAddress(landmarks[i]) 
+        != Address::fromBytes(addresses + i * Address::SIZE)) {
+      return false;
+    }
+  }
+
+  index.landmarks_.assign(landmarks, landmarks + k);
+  index.distances_.assign(distances, distances + g.numVertices() * k);
+  return true;
+}
+
+uint64_t LandmarkIndex::lowerBound(uint32_t v, uint32_t t) const {
+  size_t k = landmarks_.size();
+  const uint64_t* from_v = distances_.data() + static_cast<uint64_t>(v) * k;
+  const uint64_t* from_t = distances_.data() + static_cast<uint64_t>(t) * k;
+  uint64_t bound = 0;
+
+  for (size_t i = 0; i < k; ++i) {
+    if (from_v[i] == UNREACHED || from_t[i] == UNREACHED) {
+      // exactly one of them reaches this landmark, so they are not connected
+      if (from_v[i] != from_t[i]) return UNREACHED;
+      continue;
+    }
+
+    uint64_t difference = from_v[i] > from_t[i] 
+      ? from_v[i] - from_t[i] : from_t[i] - from_v[i];
+    bound = std::max(bound, difference);
+  }
+
+  return bound;
+}
+
+ShortestPath alt_shortest_path(const CSRGraph& g, const LandmarkIndex& index,
+                               uint32_t source, uint32_t target,
+                               TraversalWorkspace& workspace) {
+  ShortestPath result = {UNREACHED, {}, 0};
+  workspace.reset();
+
+  if (index.lowerBound(source, target) == UNREACHED) return result;
+
+  // vertices are queued by their distance plus the bound on the distance 
+  // left, and their distance alone is kept in the workspace
+  IndexedHeap& q = workspace.getHeap();
+  q.clear();
+  workspace.setDistance(source, 0);
+  q.pushOrDecrease(source, index.lowerBound(source, target));
+
+  while (!q.empty()) {
+    uint32_t u = q.top().second;
+    q.pop();
+    workspace.settle(u);
+
+    if (u == target) break;
+
+    uint64_t distance = workspace.getDistance(u);
+
+    for (uint64_t i = g.offset(u); i < g.offset(u + 1); ++i) {
+      uint32_t v = g.neighbor(i);
+      uint64_t temp_dist = distance + g.weight(i);
+
+      if (!workspace.wasExplored(v) && temp_dist < workspace.getDistance(v)) {
+        workspace.setDistance(v, temp_dist);
+        workspace.setParent(v, u);
+        q.pushOrDecrease(v, temp_dist + index.lowerBound(v, target));
+      }
+    }
+  }
+
+  result.settled = workspace.getSettledOrder().size();
+  if (!workspace.wasExplored(target)) return result;
+
+  result.distance = workspace.getDistance(target);
+  for (uint32_t v = target; v != TraversalWorkspace::NO_VERTEX; 
+       v = workspace.getParent(v)) {
+    result.path.push_back(v);
+  }
+  std::reverse(result.path.begin(), result.path.end());
+
+  return result;
+}
@@ -0,0 +1,119 @@
+#include "algorithms/shortest_path.h"
+
+#include <algorithm>
+
+using std::vector;
+
+/**
+ * @brief Settle the closest unsettled vertex of one direction of a 
+ * bidirectional search and relax its edges. Any edge that reaches a vertex
+ * already reached by the other direction completes a path, which replaces
+ * the best path so far if it is shorter.
+ *
+ * @param g the CSRGraph being searched.
+ * @param self the workspace of the direction being advanced.
+ * @param other the workspace of the opposite direction.
+ * @param best the length of the shortest path found so far.
+ * @param meet_self the vertex on this side of the edge joining the best path.
+ * @param meet_other the vertex on the other side of that edge.
+ */
+static void advance(const CSRGraph& g, TraversalWorkspace& self, 
+                    const TraversalWorkspace& other, uint64_t& best,
+                    uint32_t& meet_self, uint32_t& meet_other) {
+  IndexedHeap& q = self.getHeap();
+  uint64_t distance = q.top().first;
+  uint32_t u = q.top().second;
+  q.pop();
+  self.settle(u);
+
+  for (uint64_t i = g.offset(u); i < g.offset(u + 1); ++i) {
+    uint32_t v = g.neighbor(i);
+    uint64_t temp_dist = distance + g.weight(i);
+
+    if (!self.wasExplored(v) && temp_dist < self.getDistance(v)) {
+      self.setDistance(v, temp_dist);
+      self.setParent(v, u);
+      q.pushOrDecrease(v, temp_dist);
+    }
+
+    if (other.getDistance(v) != TraversalWorkspace::UNREACHED &&
+        temp_dist + other.getDistance(v) < best) {
+      best = temp_dist + other.getDistance(v);
+      meet_self = u;
+      meet_other = v;
+    }
+  }
+}
+
+/**
+ * @brief Append the vertices from the passed vertex back to the root of the
+ * search in the passed workspace by following parents.
+ */
+static void append_parents(const TraversalWorkspace& workspace, uint32_t v,
+                           vector<uint32_t>& path) {
+  for (; v != TraversalWorkspace::NO_VERTEX; v = workspace.getParent(v)) {
+    path.push_back(v);
+  }
+}
+
+ShortestPath shortest_path(const CSRGraph& g, uint32_t source, uint32_t target,
+                           TraversalWorkspace& forward, 
+                           TraversalWorkspace& backward) {
+  ShortestPath result = {TraversalWorkspace::UNREACHED, {}, 0};
+
+  if (source == target) {
+    result.distance = 0;
+    result.path.push_back(source);
+    result.settled = 1;
+    return result;
+  }
+
+  forward.reset();
+  backward.reset();
+  forward.getHeap().clear();
+  backward.getHeap().clear();
+
+  forward.setDistance(source, 0);
+  forward.getHeap().pushOrDecrease(source, 0);
+  backward.setDistance(target, 0);
+  backward.getHeap().pushOrDecrease(target, 0);
+
+  uint64_t best = TraversalWorkspace::UNREACHED;
+  uint32_t meet_forward = TraversalWorkspace::NO_VERTEX;
+  uint32_t meet_backward = TraversalWorkspace::NO_VERTEX;
+
+  while (!forward.getHeap().empty() && !backward.getHeap().empty()) {
+    uint64_t forward_top = forward.getHeap().top().first;
+    uint64_t backward_top = backward.getHeap().top().first;
+
+    // every path not found yet is at least this long
+    if (best != TraversalWorkspace::UNREACHED && 
+        forward_top + backward_top >= best) {
+      break;
+    }
+
+    if (forward_top <= backward_top) {
+      advance(g, forward, backward, best, meet_forward, meet_backward);
+    } else {
+      advance(g, backward, forward, best, meet_backward, meet_forward);
+    }
+  }
+
+  result.settled = forward.getSettledOrder().size() 
+    + backward.getSettledOrder().size();
+
+  if (best == TraversalWorkspace::UNREACHED) return result;
+
+  result.distance = best;
+  append_parents(forward, meet_forward, result.path);
+  std::reverse(result.path.begin(), result.path.end());
+  append_parents(backward, meet_backward, result.path);
+
+  return result;
+}
+
+ShortestPath shortest_path(const CSRGraph& g, uint32_t source, 
+                           uint32_t target) {
+  TraversalWorkspace forward(g), backward(g);
+  return shortest_path(g, source, target, forward, backward);
+}
@@ -0,0 +1,96 @@
+#include "algorithms/subgraph_view.h"
+#include "utils/thread_pool.h"
+
+#include <algorithm>
+
+using std::vector;
+
+/**
+ * @brief The number of vertices of the view each parallel task materializes.
+ */
+static const size_t VERTICES_PER_TASK = 1024;
+
+SubgraphView::SubgraphView() : membership_(), ranks_(1, 0), members_() { }
+
+SubgraphView::SubgraphView(uint32_t num_parent_vertices,
+                           const vector<uint32_t>& vertices)
+  : membership_(num_parent_vertices), ranks_(), members_() {
+  for (uint32_t v : vertices) membership_.set(v);
+
+  // local IDs follow parent IDs, so members are read back off the bitmap
+  ranks_.reserve(membership_.numWords() + 1);
+  members_.reserve(vertices.size());
+
+  for (uint32_t w = 0; w < membership_.numWords(); ++w) {
+    ranks_.push_back(members_.size());
+
+    for (uint64_t word = membership_.word(w); word != 0; word &= word - 1) {
+      members_.push_back(w * 64 + __builtin_ctzll(word));
+    }
+  }
+
+  ranks_.push_back(members_.size());
+}
+
+uint64_t SubgraphView::countEdges(const CSRGraph& parent) const {
+  uint64_t num_entries = 0;
+
+  for (uint32_t v : members_) {
+    for (uint64_t i = parent.offset(v); i < parent.offset(v + 1); ++i) {
+      num_entries += contains(parent.neighbor(i));
+    }
+  }
+
+  // every edge is stored once for each of its endpoints
+  return num_entries / 2;
+}
+
+CSRGraph SubgraphView::materialize(const CSRGraph& parent,
+                                   int num_threads) const {
+  uint32_t n = numVertices();
+  ThreadPool pool(std::max(num_threads, 1));
+
+  // run fn(v) for every local vertex v in parallel
+  auto parallel_vertices = [&](auto fn) {
+    pool.parallelForRange(n, VERTICES_PER_TASK, 
+                          [&](size_t begin, size_t end, int) {
+      for (size_t v = begin; v < end; ++v) fn(v);
+    });
+  };
+
+  vector<uint64_t> offsets(n + 1, 0);
+  vector<Address> addresses(n);
+
+  parallel_vertices([&](uint32_t v) {
+    uint32_t p = members_[v];
+    addresses[v] = parent.getAddress(p);
+
+    uint64_t degree = 0;
+    for (uint64_t i = parent.offset(p); i < parent.offset(p + 1); ++i) {
+      degree += contains(parent.neighbor(i));
+    }
+    offsets[v + 1] = degree;
+  });
+
+  for (uint32_t v = 0; v < n; ++v) offsets[v + 1] += offsets[v];
+
+  vector<uint32_t> neighbors(offsets[n]);
+  vector<uint64_t> weights(offsets[n]);
+
+  parallel_vertices([&](uint32_t v) {
+    uint32_t p = members_[v];
+    uint64_t next = offsets[v];
+
+    for (uint64_t i = parent.offset(p); i < parent.offset(p + 1); ++i) {
+      uint32_t local = toLocal(parent.neighbor(i));
+      if (local == NO_VERTEX) continue;
+
+      neighbors[next] = local;
+      weights[next] = parent.weight(i);
+      ++next;
+    }
+  });
+
+  return CSRGraph(std::move(offsets), std::move(neighbors),
+                  std::move(weights), std::move(addresses));
+}
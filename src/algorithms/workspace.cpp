@@ -0,0 +1,29 @@
+#include "algorithms/workspace.h"
+
+TraversalWorkspace::TraversalWorkspace(const CSRGraph& graph)
+  : states_(graph.numVertices(), 
+            VertexState{UNREACHED, 0.0, 0.0, NO_VERTEX, 0, 0, false, false}),
+    epoch_(1),
+    predecessor_offsets_(graph.numVertices() + 1),
+    predecessors_(graph.offset(graph.numVertices())),
+    settled_(),
+    heap_(graph.numVertices()),
+    radix_heap_(),
+    bucket_queue_(),
+    bucket_queue_max_weight_(0) {
+  for (uint32_t v = 0; v <= graph.numVertices(); ++v) {
+    predecessor_offsets_[v] = graph.offset(v);
+  }
+
+  settled_.reserve(graph.numVertices());
+}
+
+void TraversalWorkspace::reset() {
+  settled_.clear();
+
+  if (++epoch_ == 0) {
+    // the counter wrapped, so stamps from 2^32 searches ago would look current
+    for (VertexState& state : states_) state.epoch = 0;
+    epoch_ = 1;
+  }
+}
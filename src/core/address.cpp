@@ -0,0 +1,59 @@
+#include "core/address.h"
+
+using std::string_view;
+using std::ostream;
+using std::string;
+
+/**
+ * @brief Decode a single hexadecimal digit.
+ *
+ * @return the value of the digit, or -1 if the character is not a digit.
+ */
+static int hex_digit_value(char c) {
+  if (c >= '0' && c <= '9') return c - '0';
+  if (c >= 'a' && c <= 'f') return c - 'a' + 10;
+  if (c >= 'A' && c <= 'F') return c - 'A' + 10;
+  return -1;
+}
+
+bool Address::fromHex(string_view hex, Address& address) {
+  if (hex.size() >= 2 && hex[0] == '0' && (hex[1] == 'x' || hex[1] == 'X')) {
+    hex.remove_prefix(2);
+  }
+
+  if (hex.empty() || hex.size() > 2 * SIZE) return false;
+
+  // digits are read from least significant to most significant so that
+  // shorter addresses are padded with leading zeros
+  Address decoded;
+  size_t byte = SIZE;
+  for (size_t i = hex.size(); i > 0; i -= 2) {
+    int low = hex_digit_value(hex[i - 1]);
+    int high = i >= 2 ? hex_digit_value(hex[i - 2]) : 0;
+    if (low < 0 || high < 0) return false;
+
+    decoded.bytes_[--byte] = static_cast<uint8_t>((high << 4) | low);
+    if (i < 2) break;
+  }
+
+  address = decoded;
+  return true;
+}
+
+string Address::toHex() const {
+  static const char digits[] = "0123456789abcdef";
+
+  string hex(2 + 2 * SIZE, '0');
+  hex[1] = 'x';
+
+  for (size_t i = 0; i < SIZE; ++i) {
+    hex[2 + 2 * i] = digits[bytes_[i] >> 4];
+    hex[3 + 2 * i] = digits[bytes_[i] & 0xF];
+  }
+
+  return hex;
+}
+
+ostream& operator<<(ostream& os, const Address& address) {
+  return os << address.toHex();
+}
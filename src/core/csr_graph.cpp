@@ -0,0 +1,40 @@
+#include "core/csr_graph.h"
+
+#include <algorithm>
+
+CSRGraph::CSRGraph() 
+  : offsets_(1, 0), neighbors_(), weights_(), addresses_(), max_weight_(0) { }
+
+CSRGraph::CSRGraph(const Graph& graph) : max_weight_(0) {
+  uint32_t num_vertices = graph.numVertices();
+
+  offsets_.reserve(num_vertices + 1);
+  neighbors_.reserve(2 * graph.getEdges().size());
+  weights_.reserve(2 * graph.getEdges().size());
+  addresses_.reserve(num_vertices);
+
+  offsets_.push_back(0);
+
+  for (uint32_t id = 0; id < num_vertices; ++id) {
+    Vertex* v = graph.getVertexById(id);
+    addresses_.push_back(v->getAddress());
+
+    for (Edge* e : v->getIncidentEdges()) {
+      neighbors_.push_back(e->getAdjacentVertex(v)->getId());
+      weights_.push_back(e->getGas());
+      max_weight_ = std::max(max_weight_, e->getGas());
+    }
+
+    offsets_.push_back(neighbors_.size());
+  }
+}
+
+CSRGraph::CSRGraph(std::vector<uint64_t> offsets, 
+                   std::vector<uint32_t> neighbors,
+                   std::vector<uint64_t> weights, 
+                   std::vector<Address> addresses)
+  : offsets_(std::move(offsets)), neighbors_(std::move(neighbors)),
+    weights_(std::move(weights)), addresses_(std::move(addresses)),
+    max_weight_(0) {
+  for (uint64_t weight : weights_) max_weight_ = std::max(max_weight_, weight);
+}
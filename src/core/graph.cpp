@@ -1,29 +1,31 @@
 #include "core/graph.h"
+#include "utils/mapped_file.h"
 #include "utils/utils.h"
+#include "utils/csv.h"
 
 #include <unordered_set>
+#include <string_view>
+#include <algorithm>
 #include <iostream>
-#include <fstream>
-#include <sstream>
+#include <thread>
+#include <chrono>
 
 using std::unordered_set;
 using std::unordered_map;
-using std::stringstream;
+using std::string_view;
 using std::make_pair;
-using std::ifstream;
-using std::fstream;
 using std::string;
 using std::vector;
-using std::stack;
+using std::thread;
 using std::pair;
 
-Graph::Graph() { }
+Graph::Graph() : tracks_components_(false) { }
 
 Graph::~Graph() {
   _delete();
 }
 
-Graph::Graph(const Graph& other) {
+Graph::Graph(const Graph& other) : tracks_components_(false) {
   _copy(other);
 }
 
@@ -37,24 +39,32 @@ const Graph& Graph::operator=(const Graph& rhs) {
 }
 
 void Graph::_delete() {
-  for (pair<string, Vertex*> v : vertices_) {
-    delete v.second;
-  }
+  vertices_.clear();
+  ordered_vertices_.clear();
+  edges_.clear();
 
-  for (Edge* e : edges_) {
-    delete e;
-  }
+  // every vertex and edge is freed along with the blocks that hold them
+  edge_arena_.clear();
+  vertex_arena_.clear();
+
+  components_.clear();
+  tracks_components_ = false;
 }
 
 void Graph::_copy(const Graph& other) {
-  for (pair<string, Vertex*> v : other.getVertices()) {
-    addVertex(v.second->getAddress());
+  if (other.tracks_components_) trackComponents();
+  reserve(other.numVertices(), other.getEdges().size());
+
+  // copy vertices in ID order so that every copied vertex keeps its ID, and
+  // size each adjacency list up front so it is allocated exactly once
+  for (Vertex* v : other.ordered_vertices_) {
+    addVertex(v->getAddress())->reserveEdges(v->getIncidentEdges().size());
   }
 
   for (Edge* e : other.getEdges()) {
     addEdge(
-      getVertex(e->getSource()->getAddress()),
-      getVertex(e->getDestination()->getAddress()),
+      getVertexById(e->getSource()->getId()),
+      getVertexById(e->getDestination()->getId()),
       e->getValue(), e->getGas(), e->getGasPrice()
     );
   }
@@ -62,32 +72,66 @@ void Graph::_copy(const Graph& other) {
 
 Edge* Graph::addEdge(Vertex* source, Vertex* destination, double value, 
                      uint64_t gas, uint64_t gas_price) {
-  Edge* e = new Edge(source, destination, value, gas, gas_price);
+  Edge* e = edge_arena_.create(source, destination, value, gas, gas_price);
   edges_.push_back(e);
 
   source->addEdge(e);
   destination->addEdge(e);
 
+  if (tracks_components_) {
+    components_.unite(source->getId(), destination->getId());
+  }
+
   return e;
 }
 
-Vertex* Graph::addVertex(const string& address) {
-  Vertex* v = new Vertex(address);
-  vertices_.insert(make_pair(address, v));
+Vertex* Graph::addVertex(const Address& address) {
+  Vertex*& v = vertices_[address];
+  if (v != NULL) return v;
+
+  v = vertex_arena_.create(address, ordered_vertices_.size());
+  ordered_vertices_.push_back(v);
+  if (tracks_components_) components_.add();
 
   return v;
 }
 
-Vertex* Graph::getVertex(const string& address) const {
+Vertex* Graph::addVertex(string_view address) {
+  Address decoded;
+  return Address::fromHex(address, decoded) ? addVertex(decoded) : NULL;
+}
+
+void Graph::reserve(size_t num_vertices, size_t num_edges) {
+  vertices_.reserve(num_vertices);
+  ordered_vertices_.reserve(num_vertices);
+  edges_.reserve(num_edges);
+  vertex_arena_.reserve(
+    num_vertices - std::min(num_vertices, ordered_vertices_.size())
+  );
+  edge_arena_.reserve(num_edges - std::min(num_edges, edges_.size()));
+  if (tracks_components_) components_.reserve(num_vertices);
+}
+
+Vertex* Graph::getVertex(const Address& address) const {
   auto it = vertices_.find(address);
   return it == vertices_.end() ? NULL : it->second;
 }
 
-bool Graph::containsVertex(const string& address) const {
+Vertex* Graph::getVertex(string_view address) const {
+  Address decoded;
+  return Address::fromHex(address, decoded) ? getVertex(decoded) : NULL;
+}
+
+bool Graph::containsVertex(const Address& address) const {
   return vertices_.find(address) != vertices_.end();
 }
 
-const unordered_map<string, Vertex*>& Graph::getVertices() const {
+bool Graph::containsVertex(string_view address) const {
+  Address decoded;
+  return Address::fromHex(address, decoded) && containsVertex(decoded);
+}
+
+const unordered_map<Address, Vertex*, AddressHash>& Graph::getVertices() const {
   return vertices_;
 }
 
@@ -95,42 +139,187 @@ const vector<Edge*>& Graph::getEdges() const {
   return edges_;
 }
 
-Graph* Graph::fromFile(const string& path, bool suppress_print) {
+void Graph::trackComponents() {
+  if (tracks_components_) return;
+  tracks_components_ = true;
+
+  components_.reserve(ordered_vertices_.size());
+  for (size_t i = 0; i < ordered_vertices_.size(); ++i) components_.add();
+
+  for (Edge* e : edges_) {
+    components_.unite(e->getSource()->getId(), e->getDestination()->getId());
+  }
+}
+
+vector<uint32_t> Graph::getComponentSizes() const {
+  vector<uint32_t> sizes;
+  sizes.reserve(components_.numSets());
+
+  // the first vertex reached in each component is the lowest ID in it
+  vector<uint8_t> counted(ordered_vertices_.size(), false);
+  for (uint32_t v = 0; v < ordered_vertices_.size(); ++v) {
+    uint32_t root = components_.find(v);
+    if (!counted[root]) {
+      counted[root] = true;
+      sizes.push_back(components_.setSize(root));
+    }
+  }
+
+  return sizes;
+}
+
+vector<Vertex*> Graph::getLargestComponent() const {
+  vector<Vertex*> result;
+  if (components_.largest() == UnionFind::NO_ELEMENT) return result;
+
+  uint32_t largest = components_.largest();
+  result.reserve(components_.setSize(largest));
+
+  for (Vertex* v : ordered_vertices_) {
+    if (components_.find(v->getId()) == largest) result.push_back(v);
+  }
+
+  return result;
+}
+
+/**
+ * @brief A transaction parsed from a CSV record with both addresses already 
+ * decoded into their binary form. Used to buffer the records parsed by each 
+ * thread when loading a graph.
+ */
+struct ParsedTransaction {
+  Address from;
+  Address to;
+  double value;
+  uint64_t gas;
+  uint64_t gas_price;
+};
+
+/**
+ * @brief Tokenize every record in the passed slice of a CSV file, decode both
+ * addresses of each record, and append the well-formed records to the passed
+ * buffer. Used by each thread when loading a graph in parallel.
+ *
+ * @param chunk a std::string_view of whole lines to parse.
+ * @param records a vector to append the parsed records to.
+ * @param malformed_records a size_t incremented for each malformed record.
+ */
+static void parse_chunk(string_view chunk, vector<ParsedTransaction>* records,
+                        size_t* malformed_records) {
+  TransactionRecord record;
+  ParsedTransaction parsed;
+
+  while (!chunk.empty()) {
+    string_view line = next_line(chunk);
+    if (line.empty()) continue;
+
+    if (parse_transaction(line, record)
+        && Address::fromHex(record.from_address, parsed.from)
+        && Address::fromHex(record.to_address, parsed.to)) {
+      parsed.value = record.value;
+      parsed.gas = record.gas;
+      parsed.gas_price = record.gas_price;
+      records->push_back(parsed);
+    } else {
+      ++*malformed_records;
+    }
+  }
+}
+
+/**
+ * @brief Split the passed buffer into at most num_chunks slices of roughly 
+ * equal size. Every slice boundary falls just after a newline so that no 
+ * record is split between two slices.
+ *
+ * @param buffer a std::string_view of the records to split.
+ * @param num_chunks the number of slices to split the buffer into.
+ * @return a vector of slices that together cover the entire buffer in order.
+ */
+static vector<string_view> split_into_chunks(string_view buffer, 
+                                             size_t num_chunks) {
+  vector<string_view> chunks;
+  size_t target_size = buffer.size() / num_chunks + 1;
+
+  while (!buffer.empty()) {
+    size_t end = std::min(target_size, buffer.size());
+    size_t newline = buffer.find('\n', end - 1);
+    end = newline == string_view::npos ? buffer.size() : newline + 1;
+
+    chunks.push_back(buffer.substr(0, end));
+    buffer.remove_prefix(end);
+  }
+
+  return chunks;
+}
+
+Graph* Graph::fromFile(const string& path, bool suppress_print, 
+                       int num_threads, bool track_components) {
   clock_t c1, c2;
   c1 = clock();
+  auto wall_start = std::chrono::steady_clock::now();
   
   if (!suppress_print) {
     std::cout << "Loading graph..." << std::endl;
   }
   
   Graph* g = new Graph();
+  if (track_components) g->trackComponents();
+
+  MappedFile infile(path);
+  size_t malformed_records = 0;
+
+  if (infile.isOpen()) {
+    string_view remaining = infile.contents();
+    next_line(remaining); // skip the first line containing column names
+
+    // Tokenize newline aligned chunks of the file on separate threads. Each 
+    // thread fills its own buffer of records, so no synchronization is needed
+    // until every thread has finished.
+    vector<string_view> chunks = 
+      split_into_chunks(remaining, std::max(num_threads, 1));
+    vector<vector<ParsedTransaction>> records(chunks.size());
+    vector<size_t> malformed(chunks.size(), 0);
+
+    if (chunks.size() <= 1) {
+      for (size_t i = 0; i < chunks.size(); ++i) {
+        parse_chunk(chunks[i], &records[i], &malformed[i]);
+      }
+    } else {
+      vector<thread> threads;
+      for (size_t i = 0; i < chunks.size(); ++i) {
+        threads.emplace_back(parse_chunk, chunks[i], &records[i], &malformed[i]);
+      }
+
+      for (thread& t : threads) t.join();
+    }
 
-  ifstream infile(path);
-  string line;
-
-  if (infile.is_open()) {
-    getline(infile, line); // skip the first line containing column names
-
-    while (getline(infile, line)) {
-      stringstream comma_separated(line);
-      string csv_element, to_address, from_address, value, gas, gas_price;
-
-      getline(comma_separated, csv_element, ',');  // discard 0th index element
-      getline(comma_separated, from_address, ','); // from_address
-      getline(comma_separated, to_address, ',');   // to_address
-      getline(comma_separated, value, ',');        // truncated_value
-      getline(comma_separated, gas, ',');          // gas
-      getline(comma_separated, gas_price, ',');    // gas_price
-
-      Vertex* from = g->getVertex(from_address);
-      if (from == NULL) from = g->addVertex(from_address);
-      
-      Vertex* to = g->getVertex(to_address);
-      if (to == NULL) to = g->addVertex(to_address);
-
-      Edge* transaction = g->addEdge(
-        from, to, std::stod(value), std::stoull(gas), std::stoull(gas_price)
-      );
+    // Every well formed record becomes exactly one edge, so all edges can be
+    // placed in a single arena block. The number of vertices is not known yet.
+    size_t num_records = 0;
+    for (const vector<ParsedTransaction>& chunk_records : records) {
+      num_records += chunk_records.size();
+    }
+    g->reserve(0, num_records);
+
+    // Merge the buffers in file order so that vertices and edges are added in
+    // the same order regardless of the number of threads used. Addresses were
+    // already decoded by the parsing threads, so merging a record only costs
+    // two lookups of fixed width keys.
+    for (size_t i = 0; i < chunks.size(); ++i) {
+      malformed_records += malformed[i];
+
+      for (const ParsedTransaction& record : records[i]) {
+        Vertex* from = g->getVertex(record.from);
+        if (from == NULL) from = g->addVertex(record.from);
+        
+        Vertex* to = g->getVertex(record.to);
+        if (to == NULL) to = g->addVertex(record.to);
+
+        g->addEdge(from, to, record.value, record.gas, record.gas_price);
+      }
+
+      // release each buffer as soon as it has been merged
+      vector<ParsedTransaction>().swap(records[i]);
     }
   }
 
@@ -138,8 +327,22 @@ Graph* Graph::fromFile(const string& path, bool suppress_print) {
     std::cout << "Loaded " << g->getEdges().size() << " edges and "
               << g->getVertices().size() << " vertices." << std::endl;
 
+    if (malformed_records > 0) {
+      std::cout << YELLOW << "Skipped " << malformed_records 
+                << " malformed records." << RESET << std::endl;
+    }
+
+    if (track_components) {
+      std::cout << "Found " << g->numComponents() << " connected components."
+                << std::endl;
+    }
+
     c2 = clock();
+    std::chrono::duration<double> wall_elapsed = 
+      std::chrono::steady_clock::now() - wall_start;
     print_elapsed(c1, c2, "loading graph from csv");
+    print_throughput(infile.size(), wall_elapsed.count(), 
+                     "loading graph from csv");
   }
 
   return g;
@@ -187,21 +390,3 @@ Graph* Graph::fromVertexList(const vector<Vertex*>& vertices) {
 
   return g;
 }
-
-void Graph::pushDistanceOrderedVertex(Vertex* v) {
-  distance_ordered_vertices_.push(v);
-}
-
-Vertex* Graph::popDistanceOrderedVertex() {
-  Vertex* v = distance_ordered_vertices_.top();
-  distance_ordered_vertices_.pop();
-  return v;
-}
-
-void Graph::resetDistanceOrderedVertices() {
-  distance_ordered_vertices_ = stack<Vertex*>();
-}
-
-bool Graph::hasDistanceOrderedVertices() const {
-  return !distance_ordered_vertices_.empty();
-}
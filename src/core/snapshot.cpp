@@ -0,0 +1,245 @@
+#include "core/snapshot.h"
+#include "core/graph.h"
+#include "utils/mapped_file.h"
+#include "utils/utils.h"
+
+#include <unordered_map>
+#include <iostream>
+#include <fstream>
+#include <cstring>
+#include <chrono>
+
+using std::unordered_map;
+using std::string_view;
+using std::ofstream;
+using std::string;
+using std::vector;
+
+/**
+ * @brief Check that the passed offsets into an array of the passed size start
+ * at 0, never decrease, and end at the size, so every range they describe
+ * lies within the array.
+ *
+ * @param offsets the count + 1 offsets to check.
+ * @param count a size_t indicating the number of ranges.
+ * @param size a uint64_t indicating the size of the array.
+ * @return true if the offsets describe ranges within the array.
+ */
+static bool valid_offsets(const uint64_t* offsets, size_t count,
+                          uint64_t size) {
+  if (offsets[0] != 0 || offsets[count] != size) return false;
+
+  for (size_t i = 0; i < count; ++i) {
+    if (offsets[i] > offsets[i + 1]) return false;
+  }
+
+  return true;
+}
+
+bool Graph::toSnapshot(const string& path) const {
+  ofstream of(path, std::ios::binary | std::ios::trunc);
+  if (!of.is_open()) return false;
+
+  unordered_map<const Edge*, uint32_t> edge_indices;
+  edge_indices.reserve(edges_.size());
+  for (size_t i = 0; i < edges_.size(); ++i) {
+    edge_indices[edges_[i]] = i;
+  }
+
+  vector<uint64_t> adjacency_offsets(1, 0);
+  vector<uint8_t> addresses;
+  vector<uint32_t> adjacency;
+  addresses.reserve(ordered_vertices_.size() * Address::SIZE);
+  adjacency.reserve(2 * edges_.size());
+
+  // vertices are written in ID order, so vertex IDs survive a round trip
+  for (const Vertex* v : ordered_vertices_) {
+    const uint8_t* address = v->getAddress().data();
+    addresses.insert(addresses.end(), address, address + Address::SIZE);
+
+    for (Edge* e : v->getIncidentEdges()) {
+      adjacency.push_back(edge_indices[e]);
+    }
+    adjacency_offsets.push_back(adjacency.size());
+  }
+
+  vector<uint32_t> sources, destinations;
+  vector<double> values;
+  vector<uint64_t> gas, gas_prices;
+
+  for (Edge* e : edges_) {
+    sources.push_back(e->getSource()->getId());
+    destinations.push_back(e->getDestination()->getId());
+    values.push_back(e->getValue());
+    gas.push_back(e->getGas());
+    gas_prices.push_back(e->getGasPrice());
+  }
+
+  SnapshotHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+  header.version = SNAPSHOT_VERSION;
+  header.header_size = sizeof(SnapshotHeader);
+  header.num_vertices = ordered_vertices_.size();
+  header.num_edges = edges_.size();
+  header.address_bytes = addresses.size();
+
+  of.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  snapshot_write_array(of, addresses);
+  snapshot_write_array(of, adjacency_offsets);
+  snapshot_write_array(of, adjacency);
+  snapshot_write_array(of, sources);
+  snapshot_write_array(of, destinations);
+  snapshot_write_array(of, values);
+  snapshot_write_array(of, gas);
+  snapshot_write_array(of, gas_prices);
+
+  return of.good();
+}
+
+Graph* Graph::fromSnapshot(const string& path, bool suppress_print) {
+  clock_t c1, c2;
+  c1 = clock();
+  auto wall_start = std::chrono::steady_clock::now();
+
+  if (!suppress_print) {
+    std::cout << "Loading graph snapshot..." << std::endl;
+  }
+
+  Graph* g = new Graph();
+  MappedFile file(path);
+
+  const SnapshotHeader* header =
+    reinterpret_cast<const SnapshotHeader*>(file.data());
+
+  if (file.size() < sizeof(SnapshotHeader)
+      || memcmp(header->magic, SNAPSHOT_MAGIC, sizeof(header->magic)) != 0) {
+    if (!suppress_print) {
+      std::cout << BOLDRED << path << " is not a graph snapshot." << RESET
+                << std::endl;
+    }
+    return g;
+  }
+
+  if (header->version < SNAPSHOT_MIN_VERSION 
+      || header->version > SNAPSHOT_VERSION) {
+    if (!suppress_print) {
+      std::cout << BOLDRED << "Unsupported snapshot version "
+                << header->version << " (expected " << SNAPSHOT_MIN_VERSION 
+                << " to " << SNAPSHOT_VERSION << ")." << RESET << std::endl;
+    }
+    return g;
+  }
+
+  size_t num_vertices = header->num_vertices;
+  size_t num_edges = header->num_edges;
+  size_t offset = header->header_size;
+
+  // vertex and edge indices are stored as uint32_t, so larger counts can only
+  // come from a corrupt header
+  if (header->header_size < sizeof(SnapshotHeader)
+      || header->header_size % 8 != 0
+      || num_vertices > UINT32_MAX || num_edges > UINT32_MAX) {
+    if (!suppress_print) {
+      std::cout << BOLDRED << "Graph snapshot " << path << " is corrupt."
+                << RESET << std::endl;
+    }
+    return g;
+  }
+
+  const uint64_t *address_offsets = NULL, *adjacency_offsets, *gas, *gas_prices;
+  const uint32_t *adjacency, *sources, *destinations;
+  const uint8_t* addresses = NULL;
+  const double* values;
+  const char* address_chars = NULL;
+
+  // version 1 snapshots stored addresses as hexadecimal strings
+  bool complete = header->version == 1
+    ? snapshot_read_array(file, offset, num_vertices + 1, address_offsets)
+      && snapshot_read_array(file, offset, header->address_bytes, address_chars)
+    : header->address_bytes == num_vertices * Address::SIZE 
+      && snapshot_read_array(file, offset, header->address_bytes, addresses);
+
+  complete = complete
+    && snapshot_read_array(file, offset, num_vertices + 1, adjacency_offsets)
+    && snapshot_read_array(file, offset, 2 * num_edges, adjacency)
+    && snapshot_read_array(file, offset, num_edges, sources)
+    && snapshot_read_array(file, offset, num_edges, destinations)
+    && snapshot_read_array(file, offset, num_edges, values)
+    && snapshot_read_array(file, offset, num_edges, gas)
+    && snapshot_read_array(file, offset, num_edges, gas_prices);
+
+  if (!complete) {
+    if (!suppress_print) {
+      std::cout << BOLDRED << "Graph snapshot " << path << " is truncated."
+                << RESET << std::endl;
+    }
+    return g;
+  }
+
+  // every offset is checked before anything is sized from it
+  if (!valid_offsets(adjacency_offsets, num_vertices, 2 * num_edges)
+      || (address_offsets != NULL && !valid_offsets(
+            address_offsets, num_vertices, header->address_bytes))) {
+    if (!suppress_print) {
+      std::cout << BOLDRED << "Graph snapshot " << path << " is corrupt."
+                << RESET << std::endl;
+    }
+    return g;
+  }
+
+  g->reserve(num_vertices, num_edges);
+  vector<Vertex*> vertices(num_vertices);
+
+  for (size_t i = 0; i < num_vertices; ++i) {
+    Address address;
+
+    if (addresses != NULL) {
+      address = Address::fromBytes(addresses + i * Address::SIZE);
+    } else if (!Address::fromHex(string_view(
+                 address_chars + address_offsets[i],
+                 address_offsets[i + 1] - address_offsets[i]), address)) {
+      if (!suppress_print) {
+        std::cout << BOLDRED << "Graph snapshot " << path << " is corrupt."
+                  << RESET << std::endl;
+      }
+      delete g;
+      return new Graph();
+    }
+
+    vertices[i] = g->addVertex(address);
+
+    // size each adjacency list exactly so that adding edges never reallocates
+    vertices[i]->reserveEdges(adjacency_offsets[i + 1] - adjacency_offsets[i]);
+  }
+
+  // Edges are added in their original order, which rebuilds every adjacency
+  // list in its original order as well.
+  for (size_t i = 0; i < num_edges; ++i) {
+    if (sources[i] >= num_vertices || destinations[i] >= num_vertices) {
+      if (!suppress_print) {
+        std::cout << BOLDRED << "Graph snapshot " << path << " is corrupt."
+                  << RESET << std::endl;
+      }
+      delete g;
+      return new Graph();
+    }
+
+    g->addEdge(vertices[sources[i]], vertices[destinations[i]],
+               values[i], gas[i], gas_prices[i]);
+  }
+
+  if (!suppress_print) {
+    std::cout << "Loaded " << g->getEdges().size() << " edges and "
+              << g->getVertices().size() << " vertices." << std::endl;
+
+    c2 = clock();
+    std::chrono::duration<double> wall_elapsed =
+      std::chrono::steady_clock::now() - wall_start;
+    print_elapsed(c1, c2, "loading graph from snapshot");
+    print_throughput(file.size(), wall_elapsed.count(),
+                     "loading graph from snapshot");
+  }
+
+  return g;
+}
@@ -3,20 +3,23 @@
 using std::string;
 using std::vector;
 
-Vertex::Vertex(const string& address)
-  : address_(address), incident_edges_(), was_explored_(false),
-    distance_(0xFFFFFFFFFFFFFFFF), parent_(NULL), centrality_parents_(),
-    centrality_(0.0), dependency_(0.0) { }
+Vertex::Vertex(const Address& address, uint32_t id)
+  : address_(address), id_(id), incident_edges_(), was_explored_(false),
+    distance_(0xFFFFFFFFFFFFFFFF), parent_(NULL) { }
 
 void Vertex::addEdge(Edge* e) {
   incident_edges_.push_back(e);
 }
 
+void Vertex::reserveEdges(size_t count) {
+  incident_edges_.reserve(count);
+}
+
 const vector<Edge*>& Vertex::getIncidentEdges() const {
   return incident_edges_;
 }
 
-const string& Vertex::getAddress() const {
+const Address& Vertex::getAddress() const {
   return address_;
 }
 
@@ -44,35 +47,8 @@ void Vertex::setParent(Vertex* parent) {
   parent_ = parent; 
 }
 
-void Vertex::addCentralityParent(Vertex* parent) {
-  centrality_parents_.push_back(parent);
-}
-
-void Vertex::incrementCentrality(double amount) {
-  centrality_ += amount;
-}
-
-double Vertex::getCentrality() const {
-  return centrality_;
-}
-
-void Vertex::incrementDependency(double amount) {
-  dependency_ += amount;
-}
-
-double Vertex::getDependency() const {
-  return dependency_;
-}
-
-const vector<Vertex*>& Vertex::getCentralityParents() const {
-  return centrality_parents_;
-}
-
 void Vertex::reset() {
-  dependency_ = 0.0;
-  centrality_ = 0.0;
   parent_ = NULL;
-  centrality_parents_.clear();
   was_explored_ = false;
   distance_ = 0xFFFFFFFFFFFFFFFF;
 }
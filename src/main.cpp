@@ -1,13 +1,28 @@
 #include <unordered_map>
+#include <algorithm>
 #include <iostream>
 #include <fstream>
+#include <iomanip>
+#include <sstream>
+#include <chrono>
 #include <vector>
 #include <queue>
+#include <cstdlib>
+#include <cctype>
 
 #include "utils/argument_parser.h"
+#include "utils/query_server.h"
+#include "algorithms/contraction_hierarchy.h"
+#include "algorithms/delta_stepping.h"
+#include "algorithms/batch_queries.h"
+#include "algorithms/shortest_path.h"
+#include "algorithms/subgraph_view.h"
+#include "algorithms/hop_labels.h"
+#include "algorithms/landmarks.h"
 #include "algorithms/betweenness.h"
 #include "algorithms/dijkstras.h"
 #include "algorithms/bfs.h"
+#include "core/csr_graph.h"
 #include "utils/utils.h"
 #include "core/graph.h"
 
@@ -19,20 +34,40 @@ using std::pair;
 using std::sort;
 
 int main(int argc, char* argv[]) {
-  string dataset_filepath, cc_addresses_filepath, dijkstras_outfile;
-  string dijkstra_start_vertex;
-  bool should_run_bfs, should_run_dijkstra, verbose;
-  int num_betweenness_to_print, num_threads;
+  string dataset_filepath, snapshot_filepath, snapshot_outfile;
+  string cc_addresses_filepath, dijkstras_outfile;
+  string dijkstra_start_vertex, queue_name, path_target_vertex;
+  string hierarchy_filepath, hop_target_vertex, sources_filepath;
+  string queries_filepath, queries_outfile, socket_filepath, census_outfile;
+  bool should_run_bfs, should_validate_bfs, should_run_dijkstra, verbose;
+  int num_betweenness_to_print, num_threads, delta, num_landmarks;
+  int max_distance, num_nearest;
 
   ArgumentParser ap;
 
-  ap.add_argument("-f", true, &dataset_filepath, "The path to the dataset to load as a graph.");
-  ap.add_argument("-b", false, &should_run_bfs, "Indicates whether or not to run BFS on the graph.");
+  ap.add_argument("-f", false, &dataset_filepath, "The path to the CSV dataset to load as a graph. Either this or -g must be specified.");
+  ap.add_argument("-g", false, &snapshot_filepath, "The path to a binary graph snapshot to load instead of a CSV dataset.");
+  ap.add_argument("-w", false, &snapshot_outfile, "The path to save a binary snapshot of the loaded graph to. Does nothing if not specified.");
+  ap.add_argument("-b", false, &should_run_bfs, "Indicates whether or not to count the connected components of the graph on -t threads.");
+  ap.add_argument("-validate", false, &should_validate_bfs, "Check that the components found by -b account for every vertex and edge, at the cost of another pass over the edges.");
+  ap.add_argument("-census", false, &census_outfile, "The path to save the vertex and edge counts, total gas, and total value of every connected component found by -b to. Written as CSV if the path ends in .csv and as a binary census otherwise.");
   ap.add_argument("-d", false, &dijkstras_outfile, "The path to save the resulting shortest path distances resulting from running Dijkstra's algorithm from some vertex. Does nothing if not specified.");
   ap.add_argument("-s", false, &dijkstra_start_vertex, "Indicates the address of the address to perform Dijkstra's algorithm from.");
+  ap.add_argument("-S", false, &sources_filepath, "The path to a file of addresses, one per line, to run Dijkstra's algorithm for -d from all at once instead of from -s. Every vertex is saved with its distance from and the address of its closest source.");
+  ap.add_argument("-r", false, &max_distance, "Only save the -d distances of vertices within this much gas of the start vertex, and stop the search there.");
+  ap.add_argument("-k", false, &num_nearest, "Only save the -d distances of the k vertices closest to the start vertex, and stop the search there.");
+  ap.add_argument("-m", false, &queue_name, "The priority queue used by Dijkstra's algorithm: \"auto\" (the default), \"dial\" (bucket queue), \"radix\" (radix heap), \"heap\" (indexed 4-ary heap), or \"lazy\" (binary heap without decrease-key). \"delta\" computes the -d distances with parallel delta-stepping instead.");
+  ap.add_argument("-delta", false, &delta, "The bucket width used by delta-stepping. Defaults to the mean edge weight.");
+  ap.add_argument("-p", false, &path_target_vertex, "The address of a vertex to find the shortest path to from the vertex given by -s, using bidirectional Dijkstra.");
+  ap.add_argument("-L", false, &num_landmarks, "The number of landmarks to answer -p queries with using A* search (ALT). The landmark distances are saved next to the dataset and reused by later runs.");
+  ap.add_argument("-H", false, &hierarchy_filepath, "The path of a contraction hierarchy to answer -p queries with. The hierarchy is built and saved to this path if the file does not exist or was built for another graph.");
+  ap.add_argument("-hops", false, &hop_target_vertex, "The address of a vertex to find the number of transactions to from the vertex given by -s, using a 2-hop labeling of the graph built on -t threads.");
+  ap.add_argument("-q", false, &queries_filepath, "The path to a file of queries to answer, one per line: \"dist <source> <target>\", \"knn <source> <k>\", or \"sssp <source>\". The queries are answered on -t threads and the results are saved to -o.");
+  ap.add_argument("-o", false, &queries_outfile, "The path to save the results of the -q queries to.");
   ap.add_argument("-c", false, &num_betweenness_to_print, "Indicates the number of nodes to print the betweeness centrality of. Prints the BC of the k nodes with the largest BC.");
-  ap.add_argument("-l", false, &cc_addresses_filepath, "The path to save addresses of the largest connected component. Does nothing if not specified.");
-  ap.add_argument("-t", false, &num_threads, "The number of threads to use when computing betweenness centrality. Does nothing if not specified or if not running BC.");
+  ap.add_argument("-l", false, &cc_addresses_filepath, "The path to save addresses of the largest connected component, which is tracked while the graph is loaded. Does nothing if not specified.");
+  ap.add_argument("-u", false, &socket_filepath, "The path of a Unix domain socket to serve BFS, component, distance, path, and centrality queries on after everything else has run. Serves until a client sends SHUTDOWN.");
+  ap.add_argument("-t", false, &num_threads, "The number of threads to use when loading the dataset, when finding connected components, and when computing betweenness centrality. Runs on a single thread if not specified.");
   ap.add_argument("-v", false, &verbose, "Whether or not to print thread status when running code on multiple threads.");
 
   int arg_status = ap.parse(argc, argv);
@@ -40,115 +75,493 @@ int main(int argc, char* argv[]) {
   // error out if the arguments could not be parsed successfully
   if (arg_status == 1) return 1; 
 
-  Graph* g = Graph::fromFile(dataset_filepath);
+  // delta-stepping replaces Dijkstra's algorithm for -d only, since Brandes'
+  // algorithm needs vertices to be settled in order of distance
+  bool use_delta_stepping = queue_name == "delta";
+  QueueType queue = QueueType::AUTO;
+  if (!queue_name.empty() && !use_delta_stepping && 
+      !parse_queue_type(queue_name, queue)) {
+    std::cout << BOLDRED << "Unknown priority queue " << queue_name 
+              << ". Use one of auto, dial, radix, heap, lazy, or delta." 
+              << RESET << std::endl;
+    return 1;
+  }
+
+  if (delta < 0) {
+    std::cout << BOLDRED << "The delta-stepping bucket width must not be "
+              << "negative." << RESET << std::endl;
+    return 1;
+  }
+
+  if (max_distance < 0 || num_nearest < 0) {
+    std::cout << BOLDRED << "The search radius and the number of nearest "
+              << "vertices must not be negative." << RESET << std::endl;
+    return 1;
+  }
+
+  // delta-stepping settles vertices out of order, so it cannot stop early
+  bool bounded = max_distance > 0 || num_nearest > 0;
+  if ((bounded || !sources_filepath.empty()) && use_delta_stepping) {
+    std::cout << BOLDRED << "-r, -k, and -S cannot be combined with -m delta." 
+              << RESET << std::endl;
+    return 1;
+  }
+
+  if (queries_filepath.empty() != queries_outfile.empty()) {
+    std::cout << BOLDRED << "Specify both -q <query file> and -o <output file>"
+              << " to answer a batch of queries." << RESET << std::endl;
+    return 1;
+  }
+
+  if (dataset_filepath.empty() == snapshot_filepath.empty()) {
+    std::cout << BOLDRED << "Specify exactly one of -f <csv dataset> or "
+              << "-g <graph snapshot> to load." << RESET << std::endl;
+    return 1;
+  }
+
+  // the largest connected component is tracked while the graph is loaded, so
+  // it is known as soon as loading finishes
+  bool track_components = !cc_addresses_filepath.empty();
+  Graph* g = snapshot_filepath.empty()
+    ? Graph::fromFile(dataset_filepath, false, num_threads, track_components)
+    : Graph::fromSnapshot(snapshot_filepath);
+  if (track_components) g->trackComponents();
 
   if (g->getVertices().size() == 0) {
     std::cout << BOLDRED << "Could not load graph." << RESET << std::endl;
     return 1;
   }
 
-  Graph* largest_connected_component = NULL;
+  // results derived from the dataset are saved next to whichever file it was
+  // loaded from
+  if (dataset_filepath.empty()) dataset_filepath = snapshot_filepath;
+  string base_filepath = dataset_filepath.substr(0, dataset_filepath.size()-4);
+
+  // Save a snapshot of the graph if the CLI argument to do so was given
+  if (!snapshot_outfile.empty()) {
+    if (g->toSnapshot(snapshot_outfile)) {
+      std::cout << GREEN << "Saved a snapshot of the graph to " 
+                << snapshot_outfile << RESET << std::endl;
+    } else {
+      std::cout << BOLDRED << "Could not save a snapshot of the graph to " 
+                << snapshot_outfile << RESET << std::endl;
+    }
+  }
+
+  // Components and shortest path searches run on the compressed 
+  // representation of the graph
+  CSRGraph csr;
+  if (should_run_bfs || !dijkstras_outfile.empty() || !path_target_vertex.empty() || 
+      !hop_target_vertex.empty() || !queries_filepath.empty() || 
+      !socket_filepath.empty() || num_betweenness_to_print > 0) {
+    csr = CSRGraph(*g);
+  }
+
   std::cout << std::endl;
 
   // Run BFS if the CLI argument to do so was given
   if (should_run_bfs) {
-    run_bfs(g);
+    ComponentCensus census = run_bfs(*g, csr, num_threads, should_validate_bfs);
+
+    if (!census_outfile.empty()) {
+      bool is_csv = census_outfile.size() >= 4 && 
+        census_outfile.compare(census_outfile.size() - 4, 4, ".csv") == 0;
+
+      if (is_csv ? census.saveCsv(census_outfile) : census.save(census_outfile)) {
+        std::cout << GREEN << "Saved the component census to " 
+                  << census_outfile << RESET << std::endl;
+      } else {
+        std::cout << BOLDRED << "Could not save the component census to " 
+                  << census_outfile << RESET << std::endl;
+      }
+    }
+
     std::cout << std::endl;
   }
 
   // Find the largest connected component if the CLI argument to do so was given
   if (cc_addresses_filepath != "") {
-    vector<Vertex*> cc = find_largest_component(g);
+    vector<Vertex*> cc = g->getLargestComponent();
 
     std::cout << YELLOW << "The largest connected component contains " 
               << cc.size() << " vertices." << RESET << std::endl;
 
-    largest_connected_component = Graph::fromVertexList(cc);
-
-    std::cout << YELLOW << "The new graph produced using the largest connected" 
-              << " component consists of " 
-              << largest_connected_component->getVertices().size() 
-              << " vertices and "
-              << largest_connected_component->getEdges().size() << " egdes."
-              << RESET << std::endl;
+    // the component is written straight from the loaded graph through a view
+    // of its vertices, rather than from a copy of it
+    vector<uint32_t> ids;
+    ids.reserve(cc.size());
+    for (Vertex* v : cc) ids.push_back(v->getId());
+    SubgraphView largest(g->numVertices(), ids);
 
     std::ofstream of;
     of.open(cc_addresses_filepath);
     of << ",from_address,to_address,truncated_value,gas,gas_price" << std::endl;
 
-    for (Edge* e : largest_connected_component->getEdges()) {
-      of << "," << *e << std::endl;
+    size_t num_edges = 0;
+    for (Edge* e : g->getEdges()) {
+      if (largest.contains(e->getSource()->getId()) &&
+          largest.contains(e->getDestination()->getId())) {
+        of << "," << *e << std::endl;
+        ++num_edges;
+      }
     }
 
+    std::cout << YELLOW << "The largest connected component consists of " 
+              << largest.numVertices() << " vertices and "
+              << num_edges << " egdes." << RESET << std::endl;
+
     std::cout << GREEN << "Saved the largest connected component as a CSV to " 
               << cc_addresses_filepath << ".\n" << RESET << std::endl;
 
     of.close();
   }
 
-  if (largest_connected_component != NULL) {
-    delete largest_connected_component;
-  }
-
   // Run Dijkstra's algorithm if the CLI argument to do so was given
   if (!dijkstras_outfile.empty()) {
+    // the sources of a multi-source search, which is run instead of a search
+    // from -s if a file of sources was given
+    vector<uint32_t> sources;
+    if (!sources_filepath.empty()) {
+      std::ifstream sources_file(sources_filepath);
+      string address;
+
+      while (std::getline(sources_file, address)) {
+        if (address.empty()) continue;
+
+        Vertex* source = g->getVertex(address);
+        if (source == NULL) {
+          std::cout << YELLOW << "Could not find vertex with address " 
+                    << address << RESET << std::endl;
+        } else {
+          sources.push_back(source->getId());
+        }
+      }
+
+      if (sources.empty()) {
+        std::cout << BOLDRED << "Could not find any of the addresses in " 
+                  << sources_filepath << RESET << std::endl;
+        delete g;
+        return 1;
+      }
+    }
+
     // try and look for the vertex passed in via the command line to start from  
     Vertex* start = g->getVertex(dijkstra_start_vertex);
-    if (start == NULL) {
-      if (!dijkstra_start_vertex.empty()) {
-        std::cout << YELLOW << "Could not find vertex with address " 
-                  << dijkstra_start_vertex << RESET << std::endl;
+    if (!sources.empty()) {
+      std::cout << YELLOW << "Beginning Dijkstra's multi-source shortest path "
+                << "algorithm from " << sources.size() << " addresses..." 
+                << RESET << std::endl;
+    } else {
+      if (start == NULL) {
+        if (!dijkstra_start_vertex.empty()) {
+          std::cout << YELLOW << "Could not find vertex with address " 
+                    << dijkstra_start_vertex << RESET << std::endl;
+          
+        }
         
-      }
-      
-      start = g->getVertices().begin()->second;
-    } 
+        start = g->getVertices().begin()->second;
+      } 
 
-    std::cout << YELLOW << "Beginning Dijkstra's single source shortest path "
-              << "algorithm from vertex with address " << start->getAddress()
-              << "..." << RESET << std::endl;
+      std::cout << YELLOW << "Beginning Dijkstra's single source shortest path "
+                << "algorithm from vertex with address " << start->getAddress()
+                << "..." << RESET << std::endl;
+    }
 
-    clock_t c1 = clock();
-    dijkstra(g, start);
-    clock_t c2 = clock();
+    vector<uint64_t> distances;
+
+    // vertices are saved in the order they were settled by a bounded search
+    vector<uint32_t> nearest;
+
+    // the closest source of every vertex in a multi-source search
+    vector<uint32_t> nearest_source;
+
+    SearchLimits limits;
+    if (max_distance > 0) limits.max_distance = max_distance;
+    if (num_nearest > 0) limits.max_settled = num_nearest;
+
+    if (!sources.empty()) {
+      TraversalWorkspace workspace(csr);
+
+      clock_t c1 = clock();
+      multi_source_dijkstra(csr, sources, workspace, nearest_source, limits, 
+                            queue);
+      clock_t c2 = clock();
 
-    print_elapsed(c1, c2, "Dijkstra's algorithm");
+      print_elapsed(c1, c2, "multi-source Dijkstra's algorithm");
+
+      nearest = workspace.getSettledOrder();
+      distances.resize(csr.numVertices(), TraversalWorkspace::UNREACHED);
+      for (uint32_t v : nearest) distances[v] = workspace.getDistance(v);
+    } else if (bounded) {
+      TraversalWorkspace workspace(csr);
+
+      clock_t c1 = clock();
+      bounded_dijkstra(csr, start->getId(), workspace, limits, queue);
+      clock_t c2 = clock();
+
+      print_elapsed(c1, c2, "bounded Dijkstra's algorithm");
+
+      nearest = workspace.getSettledOrder();
+      distances.resize(csr.numVertices(), TraversalWorkspace::UNREACHED);
+      for (uint32_t v : nearest) distances[v] = workspace.getDistance(v);
+    } else if (use_delta_stepping) {
+      ThreadPool pool(num_threads);
+
+      auto wall_start = std::chrono::steady_clock::now();
+      distances = delta_stepping(csr, start->getId(), delta, pool);
+      std::chrono::duration<double> wall_elapsed = 
+        std::chrono::steady_clock::now() - wall_start;
+
+      print_wall_elapsed(wall_elapsed.count(), "delta-stepping");
+    } else {
+      TraversalWorkspace workspace(csr);
+
+      clock_t c1 = clock();
+      dijkstra(csr, start->getId(), workspace, queue);
+      clock_t c2 = clock();
+
+      print_elapsed(c1, c2, "Dijkstra's algorithm");
+
+      distances.resize(csr.numVertices());
+      for (uint32_t v = 0; v < csr.numVertices(); ++v) {
+        distances[v] = workspace.getDistance(v);
+      }
+    }
 
     std::ofstream of;
     of.open(dijkstras_outfile);
-    of << "address,incident_edges,distance" << std::endl;
+    of << "address,incident_edges,distance" 
+       << (sources.empty() ? "" : ",nearest_source") << std::endl;
+
+    auto write_distance = [&](uint32_t id) {
+      of << csr.getAddress(id) << "," << csr.degree(id) << "," << distances[id];
 
-    for (pair<string, Vertex*> v : g->getVertices()) {
-      of << v.second->getAddress() << "," << v.second->getIncidentEdges().size()
-         << "," << v.second->getDistance() << std::endl;
+      if (!sources.empty()) {
+        of << ",";
+        if (nearest_source[id] != TraversalWorkspace::NO_VERTEX) {
+          of << csr.getAddress(nearest_source[id]);
+        }
+      }
+
+      of << std::endl;
+    };
+
+    if (bounded) {
+      for (uint32_t id : nearest) write_distance(id);
+    } else {
+      for (const pair<const Address, Vertex*>& v : g->getVertices()) {
+        write_distance(v.second->getId());
+      }
     }
 
     std::cout << GREEN << "Saved all shortest paths to " << dijkstras_outfile 
               << RESET << "\n" << std::endl;
   }
 
+  // Find the shortest path between two vertices if the CLI argument to do so
+  // was given
+  if (!path_target_vertex.empty()) {
+    Vertex* source = g->getVertex(dijkstra_start_vertex);
+    Vertex* target = g->getVertex(path_target_vertex);
+
+    if (source == NULL || target == NULL) {
+      std::cout << BOLDRED << "Could not find vertex with address " 
+                << (source == NULL ? dijkstra_start_vertex : path_target_vertex)
+                << ". Pass the endpoints of the path with -s and -p." 
+                << RESET << "\n" << std::endl;
+    } else {
+      ShortestPath result;
+
+      if (!hierarchy_filepath.empty()) {
+        // reuse the hierarchy of an earlier run when it matches this graph
+        ContractionHierarchy hierarchy;
+
+        if (!ContractionHierarchy::load(hierarchy_filepath, csr, hierarchy)) {
+          auto wall_start = std::chrono::steady_clock::now();
+          hierarchy = ContractionHierarchy::build(csr, num_threads);
+          std::chrono::duration<double> wall_elapsed = 
+            std::chrono::steady_clock::now() - wall_start;
+          print_wall_elapsed(wall_elapsed.count(), 
+                             "building the contraction hierarchy");
+
+          std::cout << YELLOW << "The contraction hierarchy added " 
+                    << hierarchy.numShortcuts() << " shortcuts." << RESET << std::endl;
+
+          if (hierarchy.save(hierarchy_filepath, csr)) {
+            std::cout << GREEN << "Saved the contraction hierarchy to " 
+                      << hierarchy_filepath << RESET << std::endl;
+          }
+        } else {
+          std::cout << GREEN << "Loaded the contraction hierarchy from " 
+                    << hierarchy_filepath << RESET << std::endl;
+        }
+
+        TraversalWorkspace forward(csr), backward(csr);
+
+        clock_t c1 = clock();
+        result = hierarchy.query(source->getId(), target->getId(), forward, 
+                                 backward);
+        clock_t c2 = clock();
+
+        print_elapsed(c1, c2, "contraction hierarchy query");
+      } else if (num_landmarks > 0) {
+        // reuse the landmark distances of an earlier run when they exist
+        LandmarkIndex index;
+        string landmarks_filepath = base_filepath + "_landmarks.bin";
+
+        if (!LandmarkIndex::load(landmarks_filepath, csr, index) 
+            || index.numLandmarks() != static_cast<uint32_t>(num_landmarks)) {
+          clock_t c1 = clock();
+          index = LandmarkIndex::build(csr, num_landmarks, num_threads);
+          clock_t c2 = clock();
+          print_elapsed(c1, c2, "computing landmark distances");
+
+          if (index.save(landmarks_filepath, csr)) {
+            std::cout << GREEN << "Saved landmark distances to " 
+                      << landmarks_filepath << RESET << std::endl;
+          }
+        } else {
+          std::cout << GREEN << "Loaded landmark distances from " 
+                    << landmarks_filepath << RESET << std::endl;
+        }
+
+        TraversalWorkspace workspace(csr);
+
+        clock_t c1 = clock();
+        result = alt_shortest_path(csr, index, source->getId(), 
+                                   target->getId(), workspace);
+        clock_t c2 = clock();
+
+        print_elapsed(c1, c2, "A* search with landmarks");
+      } else {
+        clock_t c1 = clock();
+        result = shortest_path(csr, source->getId(), target->getId());
+        clock_t c2 = clock();
+
+        print_elapsed(c1, c2, "bidirectional Dijkstra's algorithm");
+      }
+
+      if (result.path.empty()) {
+        std::cout << YELLOW << "There is no path from " << source->getAddress()
+                  << " to " << target->getAddress() << "." << RESET 
+                  << std::endl;
+      } else {
+        std::cout << YELLOW << "The shortest path from " 
+                  << source->getAddress() << " to " << target->getAddress() 
+                  << " uses " << result.distance << " gas over " 
+                  << result.path.size() - 1 << " transactions:" << RESET 
+                  << std::endl;
+
+        for (uint32_t id : result.path) {
+          std::cout << BLUE << "  " << csr.getAddress(id) << RESET << std::endl;
+        }
+      }
+
+      std::cout << YELLOW << "Settled " << result.settled << " of " 
+                << csr.numVertices() << " vertices." << RESET << "\n" 
+                << std::endl;
+    }
+  }
+
+  // Find the number of transactions between two vertices if the CLI argument
+  // to do so was given
+  if (!hop_target_vertex.empty()) {
+    Vertex* source = g->getVertex(dijkstra_start_vertex);
+    Vertex* target = g->getVertex(hop_target_vertex);
+
+    if (source == NULL || target == NULL) {
+      std::cout << BOLDRED << "Could not find vertex with address " 
+                << (source == NULL ? dijkstra_start_vertex : hop_target_vertex)
+                << ". Pass the endpoints with -s and -hops." 
+                << RESET << "\n" << std::endl;
+    } else {
+      auto wall_start = std::chrono::steady_clock::now();
+      HopLabeling labeling = HopLabeling::build(csr, num_threads);
+      std::chrono::duration<double> wall_elapsed = 
+        std::chrono::steady_clock::now() - wall_start;
+      print_wall_elapsed(wall_elapsed.count(), "building the hop labels");
+
+      std::cout << YELLOW << "The hop labels hold " << labeling.numEntries() 
+                << " entries (" 
+                << static_cast<double>(labeling.numEntries()) / csr.numVertices()
+                << " per vertex) in " 
+                << labeling.memoryUsage() / (1024.0 * 1024.0) << " MB." 
+                << RESET << std::endl;
+
+      clock_t c1 = clock();
+      uint32_t hops = labeling.query(source->getId(), target->getId());
+      clock_t c2 = clock();
+      print_elapsed(c1, c2, "hop distance query");
+
+      if (hops == HopLabeling::UNREACHED) {
+        std::cout << YELLOW << "There is no path from " << source->getAddress()
+                  << " to " << target->getAddress() << "." << RESET 
+                  << "\n" << std::endl;
+      } else {
+        std::cout << YELLOW << "The shortest chain of transactions from " 
+                  << source->getAddress() << " to " << target->getAddress() 
+                  << " is " << hops << " transactions long." << RESET << "\n" 
+                  << std::endl;
+      }
+    }
+  }
+
+  // Answer a file of queries if the CLI argument to do so was given
+  if (!queries_filepath.empty()) {
+    std::ifstream queries_file(queries_filepath);
+    vector<BatchQuery> queries;
+    vector<string> errors;
+
+    parse_batch_queries(queries_file, *g, queries, errors);
+
+    for (const string& error : errors) {
+      std::cout << YELLOW << "Skipping query on " << error << RESET 
+                << std::endl;
+    }
+
+    std::cout << YELLOW << "Answering " << queries.size() << " queries from "
+              << queries_filepath << "..." << RESET << std::endl;
+
+    std::ofstream of(queries_outfile);
+
+    auto wall_start = std::chrono::steady_clock::now();
+    run_batch_queries(csr, queries, of, num_threads, queue);
+    std::chrono::duration<double> wall_elapsed = 
+      std::chrono::steady_clock::now() - wall_start;
+    print_wall_elapsed(wall_elapsed.count(), "answering the queries");
+
+    std::cout << GREEN << "Saved the query results to " << queries_outfile 
+              << RESET << "\n" << std::endl;
+  }
+
   // Compute betweenness centrality if the CLI argument to do so was given
+  vector<double> bc;
   if (num_betweenness_to_print > 0) {
     std::cout << YELLOW << "Computing betweenness centrality on graph..." 
               << RESET << std::endl;
     
+    // every thread shares the compressed graph read-only
     clock_t c1 = clock();
-    unordered_map<string, double> bc = 
-      compute_betweenness_centrality(g, num_threads, verbose);
+    double num_shortest_paths;
+    bc = compute_betweenness_centrality(csr, num_threads, verbose, queue,
+                                        &num_shortest_paths);
     clock_t c2 = clock();
     print_elapsed(c1, c2, "Brandes's betweenness centrality algorithm");
 
-    vector<pair<string, double>> bc_heap;
+    vector<pair<Address, double>> bc_heap;
     bc_heap.reserve(bc.size());
 
-    for (pair<string, double> p : bc)
-      bc_heap.push_back(p);
+    for (uint32_t id = 0; id < bc.size(); ++id)
+      bc_heap.push_back({csr.getAddress(id), bc[id]});
     sort(bc_heap.begin(), bc_heap.end(), compare_bc_pair);
 
     num_betweenness_to_print = 
       std::min(num_betweenness_to_print, static_cast<int>(bc_heap.size()));
 
-    std::cout << YELLOW << "There are " << g->getPathCounter() 
+    // path counts grow past what integers hold, but are whole numbers
+    std::ostringstream paths;
+    paths << std::fixed << std::setprecision(0) << num_shortest_paths;
+    std::cout << YELLOW << "There are " << paths.str()
               << " shortest paths in the graph.\n" << RESET << std::endl;
 
     for (int i = 0; i < num_betweenness_to_print; ++i) {
@@ -160,12 +573,11 @@ int main(int argc, char* argv[]) {
     }
 
     std::ofstream of;
-    string base_filepath = dataset_filepath.substr(0, dataset_filepath.size()-4);
 
     of.open(base_filepath +  + "_betweenness_centrality.csv");
     of << "address,incident_edges,betweenness_centrality" << std::endl;
 
-    for (pair<string, double>& p : bc_heap) {
+    for (pair<Address, double>& p : bc_heap) {
       Vertex* v = g->getVertex(p.first);
       of << v->getAddress() << "," << v->getIncidentEdges().size()
          << "," << p.second << std::endl;
@@ -180,5 +592,66 @@ int main(int argc, char* argv[]) {
     std::cout << std::endl;
   }
 
+  // Serve queries over a socket if the CLI argument to do so was given
+  if (!socket_filepath.empty()) {
+    // centrality saved by an earlier run with -c is served if it was not 
+    // computed in this run
+    string bc_filepath = base_filepath + "_betweenness_centrality.csv";
+    std::ifstream bc_file(bc_filepath);
+
+    if (bc.empty() && bc_file.is_open()) {
+      bc.assign(csr.numVertices(), 0.0);
+      string line;
+      size_t malformed_lines = 0;
+      std::getline(bc_file, line);
+
+      // a truncated or edited file must not stop the server from starting, so
+      // lines without a whole number after their last comma are skipped
+      while (std::getline(bc_file, line)) {
+        if (!line.empty() && line.back() == '\r') line.pop_back();
+
+        size_t first_comma = line.find(',');
+        size_t last_comma = line.rfind(',');
+        const char* value = line.c_str() + last_comma + 1;
+        double centrality = 0.0;
+        bool valid = last_comma != string::npos && *value != '\0'
+                     && !isspace(static_cast<unsigned char>(*value));
+        if (valid) {
+          char* end;
+          centrality = strtod(value, &end);
+          valid = *end == '\0';
+        }
+
+        if (!valid) {
+          ++malformed_lines;
+          continue;
+        }
+
+        Vertex* v = g->getVertex(line.substr(0, first_comma));
+        if (v != NULL) bc[v->getId()] = centrality;
+      }
+
+      std::cout << GREEN << "Loaded betweenness centrality from " 
+                << bc_filepath << RESET << std::endl;
+      if (malformed_lines > 0) {
+        std::cout << YELLOW << "Skipped " << malformed_lines 
+                  << " malformed lines." << RESET << std::endl;
+      }
+    }
+
+    QueryServer server(*g, csr, std::move(bc), num_threads);
+
+    if (!server.listen(socket_filepath)) {
+      std::cout << BOLDRED << "Could not listen on " << socket_filepath 
+                << RESET << std::endl;
+    } else {
+      std::cout << GREEN << "Serving queries on " << socket_filepath 
+                << " with " << std::max(num_threads, 1) << " workers..." 
+                << RESET << std::endl;
+      server.serve();
+      std::cout << GREEN << "Stopped serving queries." << RESET << std::endl;
+    }
+  }
+
   delete g;
 }
@@ -0,0 +1,101 @@
+#include "utils/csv.h"
+
+#include <cstdlib>
+#include <cstring>
+#include <cctype>
+
+using std::string_view;
+
+/**
+ * @brief The longest numeric field that is parsed. Longer fields are treated
+ * as malformed.
+ */
+static const size_t MAX_NUMBER_LENGTH = 127;
+
+/**
+ * @brief Split the next comma separated field off of the front of the passed
+ * record.
+ *
+ * @param line the remainder of the record, advanced past the returned field
+ * and its trailing comma.
+ * @return a std::string_view of the next field.
+ */
+static string_view next_field(string_view& line) {
+  size_t comma = line.find(',');
+  string_view field = line.substr(0, comma);
+  line.remove_prefix(comma == string_view::npos ? line.size() : comma + 1);
+  return field;
+}
+
+/**
+ * @brief Parse the entirety of the passed field as an unsigned decimal
+ * integer.
+ *
+ * @return true if the field held only digits and the number fit in a
+ * uint64_t.
+ */
+static bool parse_number(string_view field, uint64_t& out) {
+  if (field.empty()) return false;
+
+  uint64_t number = 0;
+  for (char c : field) {
+    if (c < '0' || c > '9') return false;
+
+    uint64_t digit = c - '0';
+    if (number > (UINT64_MAX - digit) / 10) return false;
+    number = number * 10 + digit;
+  }
+
+  out = number;
+  return true;
+}
+
+/**
+ * @brief Parse the entirety of the passed field as a floating point number.
+ * The field is copied so that strtod, which needs a terminated string, cannot
+ * read past the end of the field into the rest of the file.
+ *
+ * @return true if every character of the field was consumed by the parse.
+ */
+static bool parse_number(string_view field, double& out) {
+  if (field.empty() || field.size() > MAX_NUMBER_LENGTH
+      || isspace(static_cast<unsigned char>(field[0]))) {
+    return false;
+  }
+
+  char buffer[MAX_NUMBER_LENGTH + 1];
+  memcpy(buffer, field.data(), field.size());
+  buffer[field.size()] = '\0';
+
+  char* end;
+  out = strtod(buffer, &end);
+  return end == buffer + field.size();
+}
+
+string_view next_line(string_view& buffer) {
+  const char* newline = static_cast<const char*>(
+    memchr(buffer.data(), '\n', buffer.size())
+  );
+
+  size_t length = newline == NULL ? buffer.size() : newline - buffer.data();
+  string_view line = buffer.substr(0, length);
+  buffer.remove_prefix(newline == NULL ? length : length + 1);
+
+  if (!line.empty() && line.back() == '\r') line.remove_suffix(1);
+  return line;
+}
+
+bool parse_transaction(string_view line, TransactionRecord& record) {
+  next_field(line);                              // discard 0th index element
+  record.from_address = next_field(line);        // from_address
+  record.to_address = next_field(line);          // to_address
+  string_view value = next_field(line);          // truncated_value
+  string_view gas = next_field(line);            // gas
+  string_view gas_price = next_field(line);      // gas_price
+
+  if (record.from_address.empty() || record.to_address.empty()) return false;
+
+  return parse_number(value, record.value)
+      && parse_number(gas, record.gas)
+      && parse_number(gas_price, record.gas_price);
+}
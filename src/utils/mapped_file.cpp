@@ -0,0 +1,44 @@
+#include "utils/mapped_file.h"
+
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <fcntl.h>
+#include <unistd.h>
+
+using std::string;
+
+MappedFile::MappedFile(const string& path)
+  : data_(NULL), size_(0), open_(false) {
+  int fd = open(path.c_str(), O_RDONLY);
+  if (fd < 0) return;
+
+  struct stat st;
+  if (fstat(fd, &st) == 0) {
+    size_ = static_cast<size_t>(st.st_size);
+
+    if (size_ == 0) {
+      // mmap rejects empty mappings, but an empty file is still a valid file
+      open_ = true;
+    } else {
+      void* mapped = mmap(NULL, size_, PROT_READ, MAP_PRIVATE, fd, 0);
+
+      if (mapped != MAP_FAILED) {
+        // the file is read front to back, so let the kernel read ahead
+        madvise(mapped, size_, MADV_SEQUENTIAL);
+        data_ = static_cast<const char*>(mapped);
+        open_ = true;
+      } else {
+        size_ = 0;
+      }
+    }
+  }
+
+  // the mapping stays valid after the descriptor is closed
+  close(fd);
+}
+
+MappedFile::~MappedFile() {
+  if (data_ != NULL) {
+    munmap(const_cast<char*>(data_), size_);
+  }
+}
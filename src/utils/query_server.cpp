@@ -0,0 +1,408 @@
+#include "utils/query_server.h"
+#include "algorithms/shortest_path.h"
+#include "algorithms/connected_components.h"
+
+#include <sys/socket.h>
+#include <sys/stat.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <fcntl.h>
+#include <poll.h>
+
+#include <unordered_map>
+#include <cstring>
+#include <cerrno>
+#include <sstream>
+#include <thread>
+
+using std::unordered_map;
+using std::istringstream;
+using std::ostringstream;
+using std::unique_lock;
+using std::mutex;
+using std::string;
+using std::vector;
+
+/**
+ * @brief How long `serve` waits for connections, requests, and responses
+ * before checking whether the server was stopped, in milliseconds.
+ */
+static const int POLL_INTERVAL_MS = 100;
+
+/**
+ * @brief The longest request line accepted. Connections that send longer
+ * lines are closed.
+ */
+static const size_t MAX_REQUEST_SIZE = 4096;
+
+QueryServer::QueryServer(const Graph& g, const CSRGraph& csr,
+                         vector<double> centrality, int num_workers)
+  : graph_(g), csr_(csr), centrality_(std::move(centrality)), components_(),
+    component_sizes_(), num_workers_(std::max(num_workers, 1)),
+    listen_fd_(-1), path_(), stopping_(false), mutex_(), ready_(),
+    pending_(), finished_(), done_(false), wake_fd_(-1) {
+  Components components = connected_components(csr_, num_workers_);
+  components_.swap(components.labels);
+  component_sizes_.swap(components.sizes);
+}
+
+QueryServer::~QueryServer() {
+  if (listen_fd_ != -1) close(listen_fd_);
+}
+
+bool QueryServer::listen(const string& path) {
+  sockaddr_un address;
+  memset(&address, 0, sizeof(address));
+  address.sun_family = AF_UNIX;
+  if (path.size() >= sizeof(address.sun_path)) return false;
+  memcpy(address.sun_path, path.c_str(), path.size());
+
+  // only a socket left by an earlier server may be replaced, never a file the
+  // path was mistakenly given for
+  struct stat existing;
+  if (lstat(path.c_str(), &existing) == 0) {
+    if (!S_ISSOCK(existing.st_mode)) return false;
+    unlink(path.c_str());
+  }
+
+  int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+  if (fd == -1) return false;
+
+  // every waiting connection is accepted after a poll, so accept must not
+  // block once none are left
+  fcntl(fd, F_SETFL, fcntl(fd, F_GETFL) | O_NONBLOCK);
+
+  if (bind(fd, reinterpret_cast<sockaddr*>(&address), sizeof(address)) == -1
+      || ::listen(fd, SOMAXCONN) == -1) {
+    close(fd);
+    return false;
+  }
+
+  listen_fd_ = fd;
+  path_ = path;
+  return true;
+}
+
+/**
+ * @brief The state `serve` keeps for each connected client.
+ */
+struct Connection {
+  /**
+   * @brief Received bytes that are not yet a handed out request.
+   */
+  string input;
+
+  /**
+   * @brief Response bytes that are not yet sent.
+   */
+  string output;
+
+  /**
+   * @brief Whether a worker is answering a request of this connection.
+   */
+  bool busy = false;
+
+  /**
+   * @brief Whether no more requests will be read, because the client closed
+   * its end, sent QUIT, or sent too long a line. Requests already received
+   * are still answered.
+   */
+  bool finished = false;
+
+  /**
+   * @brief Whether the connection failed and should be closed as soon as no
+   * worker is answering one of its requests.
+   */
+  bool broken = false;
+};
+
+/**
+ * @brief Split the next complete request line off of the passed connection's
+ * input, dropping the line terminator.
+ *
+ * @return true if a complete line was received.
+ */
+static bool next_request(Connection& connection, string& request) {
+  size_t end = connection.input.find('\n');
+  if (end == string::npos) return false;
+
+  request = connection.input.substr(0, end);
+  connection.input.erase(0, end + 1);
+  if (!request.empty() && request.back() == '\r') request.pop_back();
+  return true;
+}
+
+/**
+ * @brief Send as much of the passed connection's output as the socket takes
+ * without blocking, marking the connection broken if the send fails.
+ */
+static void flush_output(int fd, Connection& connection) {
+  while (!connection.output.empty()) {
+    ssize_t written = send(fd, connection.output.data(),
+                           connection.output.size(),
+                           MSG_NOSIGNAL | MSG_DONTWAIT);
+    if (written <= 0) {
+      if (written == -1 && (errno == EAGAIN || errno == EWOULDBLOCK)) return;
+      connection.broken = true;
+      return;
+    }
+
+    connection.output.erase(0, written);
+  }
+}
+
+void QueryServer::serve() {
+  int wake[2];
+  if (pipe(wake) == -1) return;
+  fcntl(wake[0], F_SETFL, fcntl(wake[0], F_GETFL) | O_NONBLOCK);
+  fcntl(wake[1], F_SETFL, fcntl(wake[1], F_GETFL) | O_NONBLOCK);
+  wake_fd_ = wake[1];
+  done_ = false;
+
+  vector<std::thread> workers;
+  for (int i = 0; i < num_workers_; ++i) {
+    workers.emplace_back(&QueryServer::workerLoop, this);
+  }
+
+  unordered_map<int, Connection> connections;
+  vector<pollfd> polled;
+
+  while (true) {
+    bool answering = false, sending = false;
+    for (const auto& entry : connections) {
+      answering |= entry.second.busy;
+      sending |= !entry.second.output.empty() && !entry.second.broken;
+    }
+    if (stopping_ && !answering && !sending) break;
+
+    // busy connections are not read, so a client cannot queue up requests
+    // faster than they are answered. Connections with nothing to wait for
+    // are left out, since poll reports a hang up even when it is not asked to.
+    polled.clear();
+    polled.push_back({wake[0], POLLIN, 0});
+    if (!stopping_) polled.push_back({listen_fd_, POLLIN, 0});
+    for (const auto& entry : connections) {
+      const Connection& c = entry.second;
+      short events = 0;
+      if (!c.busy && !c.finished && !stopping_) events |= POLLIN;
+      if (!c.output.empty()) events |= POLLOUT;
+      if (events != 0) polled.push_back({entry.first, events, 0});
+    }
+
+    if (poll(polled.data(), polled.size(), POLL_INTERVAL_MS) == -1
+        && errno != EINTR) {
+      break;
+    }
+
+    char drained[64];
+    while (read(wake[0], drained, sizeof(drained)) > 0) { }
+
+    vector<Job> finished;
+    {
+      std::lock_guard<mutex> lock(mutex_);
+      finished.swap(finished_);
+    }
+
+    for (Job& job : finished) {
+      Connection& c = connections[job.fd];
+      c.busy = false;
+      if (!c.broken) c.output += job.response + "\n";
+    }
+
+    for (const pollfd& p : polled) {
+      if (p.fd == wake[0] || p.fd == listen_fd_) continue;
+
+      Connection& c = connections[p.fd];
+      if (p.revents & POLLOUT) flush_output(p.fd, c);
+      if (!(p.events & POLLIN)
+          || !(p.revents & (POLLIN | POLLHUP | POLLERR))) {
+        continue;
+      }
+
+      char chunk[4096];
+      ssize_t received = recv(p.fd, chunk, sizeof(chunk), MSG_DONTWAIT);
+      if (received > 0) {
+        c.input.append(chunk, received);
+      } else if (received == 0) {
+        c.finished = true;
+      } else if (errno != EAGAIN && errno != EWOULDBLOCK) {
+        c.broken = true;
+      }
+    }
+
+    // hand out the next request of every connection that is not busy
+    for (auto& entry : connections) {
+      Connection& c = entry.second;
+      if (c.busy || c.broken || stopping_) continue;
+
+      string request;
+      if (!next_request(c, request)) {
+        // a line this long is not a request, so the client is not read again
+        if (c.input.size() > MAX_REQUEST_SIZE) {
+          c.input.clear();
+          c.finished = true;
+        }
+        continue;
+      }
+
+      if (request == "QUIT") {
+        c.input.clear();
+        c.finished = true;
+        continue;
+      }
+
+      c.busy = true;
+      std::lock_guard<mutex> lock(mutex_);
+      pending_.push_back({entry.first, std::move(request), string()});
+      ready_.notify_one();
+    }
+
+    for (auto it = connections.begin(); it != connections.end(); ) {
+      const Connection& c = it->second;
+      bool idle = !c.busy && c.input.find('\n') == string::npos;
+      if (!c.busy && (c.broken || (c.finished && idle && c.output.empty()))) {
+        close(it->first);
+        it = connections.erase(it);
+      } else {
+        ++it;
+      }
+    }
+
+    if (!stopping_) {
+      int fd;
+      while ((fd = accept(listen_fd_, NULL, NULL)) != -1) {
+        connections[fd] = Connection();
+      }
+    }
+  }
+
+  {
+    std::lock_guard<mutex> lock(mutex_);
+    done_ = true;
+    ready_.notify_all();
+  }
+  for (std::thread& worker : workers) worker.join();
+
+  for (const auto& entry : connections) close(entry.first);
+  close(wake[0]);
+  close(wake[1]);
+  wake_fd_ = -1;
+
+  close(listen_fd_);
+  listen_fd_ = -1;
+  unlink(path_.c_str());
+}
+
+void QueryServer::workerLoop() {
+  // workspaces are only allocated once the worker answers a request
+  std::unique_ptr<Workspaces> workspaces;
+  unique_lock<mutex> lock(mutex_);
+
+  while (true) {
+    ready_.wait(lock, [&]() { return done_ || !pending_.empty(); });
+    if (pending_.empty()) return;
+
+    Job job = std::move(pending_.front());
+    pending_.pop_front();
+    lock.unlock();
+
+    if (!workspaces) workspaces.reset(new Workspaces(csr_));
+    job.response = answer(job.request, *workspaces);
+
+    lock.lock();
+    finished_.push_back(std::move(job));
+
+    // a full pipe already wakes serve, so a failed write is harmless
+    char wake = 0;
+    if (write(wake_fd_, &wake, 1) == -1) { }
+  }
+}
+
+string QueryServer::answer(const string& request) {
+  Workspaces workspaces(csr_);
+  return answer(request, workspaces);
+}
+
+string QueryServer::answer(const string& request, Workspaces& workspaces) {
+  istringstream fields(request);
+  string command, first, second;
+  fields >> command >> first >> second;
+
+  // looks up the ID of an address, setting the error response if it is not
+  // in the graph
+  string error;
+  auto lookup = [&](const string& address, uint32_t& id) {
+    Vertex* v = graph_.getVertex(address);
+    if (v == NULL) {
+      error = "ERR unknown address " + address;
+      return false;
+    }
+
+    id = v->getId();
+    return true;
+  };
+
+  uint32_t source, target;
+  ostringstream response;
+
+  if (command == "PING") {
+    return "OK pong";
+  } else if (command == "SHUTDOWN") {
+    stop();
+    return "OK shutting down";
+  } else if (command == "BFS") {
+    if (!lookup(first, source)) return error;
+
+    // the settle order of the workspace doubles as the BFS queue
+    TraversalWorkspace& workspace = workspaces.forward;
+    workspace.reset();
+    workspace.setDistance(source, 0);
+    workspace.settle(source);
+
+    const vector<uint32_t>& queue = workspace.getSettledOrder();
+    for (size_t head = 0; head < queue.size(); ++head) {
+      uint32_t u = queue[head];
+      uint64_t hops = workspace.getDistance(u) + 1;
+
+      for (uint64_t i = csr_.offset(u); i < csr_.offset(u + 1); ++i) {
+        uint32_t v = csr_.neighbor(i);
+        if (!workspace.wasExplored(v)) {
+          workspace.setDistance(v, hops);
+          workspace.settle(v);
+        }
+      }
+    }
+
+    response << "OK " << queue.size() << " "
+             << workspace.getDistance(queue.back());
+  } else if (command == "COMPONENT") {
+    if (!lookup(first, source)) return error;
+
+    response << "OK " << components_[source] << " "
+             << component_sizes_[components_[source]];
+  } else if (command == "DIST" || command == "PATH") {
+    if (!lookup(first, source) || !lookup(second, target)) return error;
+
+    ShortestPath result = shortest_path(csr_, source, target,
+                                        workspaces.forward,
+                                        workspaces.backward);
+
+    if (result.distance == TraversalWorkspace::UNREACHED) {
+      return "OK unreachable";
+    }
+
+    response << "OK " << result.distance;
+    if (command == "PATH") {
+      for (uint32_t v : result.path) response << " " << csr_.getAddress(v);
+    }
+  } else if (command == "CENTRALITY") {
+    if (!lookup(first, source)) return error;
+    if (centrality_.empty()) return "ERR betweenness centrality not computed";
+
+    response << "OK " << centrality_[source];
+  } else {
+    return "ERR unknown request " + command;
+  }
+
+  return response.str();
+}
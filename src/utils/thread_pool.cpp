@@ -0,0 +1,90 @@
+#include "utils/thread_pool.h"
+
+#include <algorithm>
+
+using std::unique_lock;
+using std::function;
+using std::mutex;
+
+ThreadPool::ThreadPool(int num_threads)
+  : workers_(), task_(NULL), num_tasks_(0), next_task_(0), generation_(0),
+    busy_workers_(0), stopping_(false) {
+  for (int i = 1; i < num_threads; ++i) {
+    workers_.emplace_back(&ThreadPool::workerLoop, this, i);
+  }
+}
+
+ThreadPool::~ThreadPool() {
+  {
+    unique_lock<mutex> lock(mutex_);
+    stopping_ = true;
+  }
+
+  start_.notify_all();
+  for (std::thread& worker : workers_) worker.join();
+}
+
+void ThreadPool::parallelFor(size_t num_tasks, 
+                             const function<void(size_t, int)>& task) {
+  if (workers_.empty() || num_tasks <= 1) {
+    for (size_t i = 0; i < num_tasks; ++i) task(i, 0);
+    return;
+  }
+
+  {
+    unique_lock<mutex> lock(mutex_);
+    task_ = &task;
+    num_tasks_ = num_tasks;
+    next_task_ = 0;
+    busy_workers_ = workers_.size();
+    ++generation_;
+  }
+
+  start_.notify_all();
+  runTasks(0);
+
+  unique_lock<mutex> lock(mutex_);
+  done_.wait(lock, [this] { return busy_workers_ == 0; });
+  task_ = NULL;
+}
+
+void ThreadPool::parallelForRange(size_t n, size_t block,
+    const function<void(size_t, size_t, int)>& fn) {
+  size_t num_blocks = (n + block - 1) / block;
+
+  parallelFor(num_blocks, [&](size_t i, int thread) {
+    size_t begin = i * block;
+    fn(begin, std::min(n, begin + block), thread);
+  });
+}
+
+void ThreadPool::workerLoop(int thread_index) {
+  size_t seen_generation = 0;
+
+  while (true) {
+    {
+      unique_lock<mutex> lock(mutex_);
+      start_.wait(lock, [&] { 
+        return stopping_ || generation_ != seen_generation; 
+      });
+
+      if (stopping_) return;
+      seen_generation = generation_;
+    }
+
+    runTasks(thread_index);
+
+    {
+      unique_lock<mutex> lock(mutex_);
+      --busy_workers_;
+    }
+
+    done_.notify_one();
+  }
+}
+
+void ThreadPool::runTasks(int thread_index) {
+  for (size_t i = next_task_++; i < num_tasks_; i = next_task_++) {
+    (*task_)(i, thread_index);
+  }
+}
@@ -10,6 +10,20 @@ void print_elapsed(clock_t& c1, clock_t& c2, const std::string_view& action) {
             << " seconds." << RESET << std::endl;
 }
 
-bool compare_bc_pair(const pair<string, double>& p1, const pair<string, double>& p2) {
+void print_wall_elapsed(double seconds, const std::string_view& action) {
+  std::cout << CYAN << "Elapsed wall clock time for " << action << " was " 
+            << seconds << " seconds." << RESET << std::endl;
+}
+
+void print_throughput(size_t bytes, double seconds, 
+                      const std::string_view& action) {
+  double megabytes = bytes / 1e6;
+  std::cout << CYAN << "Throughput for " << action << " was " 
+            << (seconds > 0 ? megabytes / seconds : 0.0) << " MB/s (" 
+            << megabytes << " MB in " << seconds << " seconds)." << RESET 
+            << std::endl;
+}
+
+bool compare_bc_pair(const pair<Address, double>& p1, const pair<Address, double>& p2) {
   return p1.second > p2.second;
 }
@@ -8,9 +8,11 @@
 #include <unordered_map>
 #include <iostream>
 #include <string>
+#include <vector>
 
 using std::unordered_map;
 using std::string;
+using std::vector;
 
 /**
  * All Edge Weights are 1:
@@ -66,7 +68,7 @@ TEST_CASE("Simple Betweenness Centrality on Graph with Equal Edge Weights", "[be
   g.addEdge(d, f, 1, 1, 1);
   g.addEdge(e, f, 1, 1, 1);
 
-  unordered_map<string, double> results = compute_betweenness_centrality(&g);
+  CentralityMap results = compute_betweenness_centrality(&g);
 
   REQUIRE( results[a->getAddress()] == 0.0 );
   REQUIRE( results[b->getAddress()] == 0.0 );
@@ -130,7 +132,7 @@ TEST_CASE("Simple Betweenness Centrality 2", "[betweenness]") {
   g.addEdge(b, d, 1, 1, 1);
   g.addEdge(d, c, 1, 1, 1);
 
-  unordered_map<string, double> results = compute_betweenness_centrality(&g);
+  CentralityMap results = compute_betweenness_centrality(&g);
 
   REQUIRE( results[a->getAddress()] == 1.5 );
   REQUIRE( results[b->getAddress()] == 2.5 );
@@ -171,17 +173,14 @@ TEST_CASE("Betweenness Centrality on Weighted Graph (unequal edge weights)", "[b
   g.addEdge(d, c, 1, 1, 1);
 
 
-  unordered_map<string, double> results = compute_betweenness_centrality(&g);
+  CentralityMap results = compute_betweenness_centrality(&g);
 
-  double actual = results[a->getAddress()];
-  double expected = 3.25;
-
-  REQUIRE( results[a->getAddress()] == Approx(3.25).epsilon(1e-5) );  
-  REQUIRE( results[b->getAddress()] == Approx(3.8333333).epsilon(1e-5) ); 
-  REQUIRE( results[c->getAddress()] == Approx(1.5833333).epsilon(1e-5) );  
-  REQUIRE( results[d->getAddress()] == Approx(1.8333333).epsilon(1e-5) ); 
-  REQUIRE( results[e->getAddress()] == Approx(1.4166667).epsilon(1e-5) ); 
-  REQUIRE( results[f->getAddress()] == Approx(0.1666667).epsilon(1e-5) ); 
+  REQUIRE( results[a->getAddress()] == Approx(3.5).epsilon(1e-5) );  
+  REQUIRE( results[b->getAddress()] == Approx(4.0).epsilon(1e-5) ); 
+  REQUIRE( results[c->getAddress()] == Approx(1.5).epsilon(1e-5) );  
+  REQUIRE( results[d->getAddress()] == Approx(3.5).epsilon(1e-5) ); 
+  REQUIRE( results[e->getAddress()] == Approx(1.5).epsilon(1e-5) ); 
+  REQUIRE( results[f->getAddress()] == Approx(0.0).epsilon(1e-5) ); 
 }
 
 /**
@@ -216,8 +215,11 @@ TEST_CASE("Betweenness Centrality on Weighted Graph (unequal edge weights)", "[b
  *          - B --> C --> D       (+1.0)
  *      - E: 0.0
  *          - E is not a central node in any shortest paths
- *      - F: 0.0
- *          - F is not a central node in any shortest paths
+ *      - F: 4.0
+ *          - A --> C --> D --> F --> E (+1.0)
+ *          - B --> C --> D --> F --> E (+1.0)
+ *          - C --> D --> F --> E       (+1.0)
+ *          - D --> F --> E             (+1.0)
  *
  */
 TEST_CASE("Betweenness Centrality on Weighted Graph (unequal edge weights) 2", "[betweenness]") {
@@ -238,14 +240,14 @@ TEST_CASE("Betweenness Centrality on Weighted Graph (unequal edge weights) 2", "
   g.addEdge(d, f, 1, 1, 1);
   g.addEdge(e, f, 1, 1, 1);
 
-  unordered_map<string, double> results = compute_betweenness_centrality(&g);
+  CentralityMap results = compute_betweenness_centrality(&g);
 
   REQUIRE( results[a->getAddress()] == 0.0 );
   REQUIRE( results[b->getAddress()] == 0.0 );
   REQUIRE( results[c->getAddress()] == 6.0 );
   REQUIRE( results[d->getAddress()] == 6.0 );
   REQUIRE( results[e->getAddress()] == 0.0 );
-  REQUIRE( results[f->getAddress()] == 2.0 );
+  REQUIRE( results[f->getAddress()] == 4.0 );
 }
 
 /**
@@ -337,7 +339,7 @@ TEST_CASE("Complex Betweenness Centrality with Equal Edge Weights", "[betweennes
   graph.addEdge(f, g, 1, 1, 51);
   graph.addEdge(g, h, 1, 1, 1);
 
-  unordered_map<string, double> results = compute_betweenness_centrality(&graph);
+  CentralityMap results = compute_betweenness_centrality(&graph);
 
   REQUIRE( results[a->getAddress()] == 1.0 );
   REQUIRE( results[b->getAddress()] == 3.0 );
@@ -348,3 +350,42 @@ TEST_CASE("Complex Betweenness Centrality with Equal Edge Weights", "[betweennes
   REQUIRE( results[g->getAddress()] == 7.0 );
   REQUIRE( results[h->getAddress()] == 0.0 );
 }
+
+/**
+ * A path of 300 vertices followed by 500 disjoint pairs, so the sources on the
+ * path cost far more to search than the rest. The i-th vertex of a path of n
+ * vertices lies between the i vertices before it and the n - 1 - i after it.
+ */
+TEST_CASE("Betweenness Centrality with Threads on Sources of Uneven Cost", "[betweenness]") {
+  const int path_length = 300;
+  const int num_pairs = 500;
+
+  Graph graph;
+  vector<Vertex*> path;
+
+  for (int i = 0; i < path_length; ++i) {
+    path.push_back(graph.addVertex("0x1" + std::to_string(i)));
+    if (i > 0) graph.addEdge(path[i - 1], path[i], 1, 1, 1);
+  }
+
+  for (int i = 0; i < num_pairs; ++i) {
+    Vertex* a = graph.addVertex("0x2" + std::to_string(i));
+    Vertex* b = graph.addVertex("0x3" + std::to_string(i));
+    graph.addEdge(a, b, 1, 1, 1);
+  }
+
+  for (int num_threads : {1, 4}) {
+    CentralityMap results = 
+      compute_betweenness_centrality(&graph, num_threads);
+
+    REQUIRE( results.size() == graph.numVertices() );
+    for (int i = 0; i < path_length; ++i) {
+      double expected = double(i) * (path_length - 1 - i);
+      REQUIRE( results[path[i]->getAddress()] == Approx(expected) );
+    }
+
+    for (const auto& entry : results) {
+      REQUIRE( entry.second >= 0.0 );
+    }
+  }
+}
@@ -3,6 +3,7 @@
 #include "graph.h"
 #include "edge.h"
 #include "bfs.h"
+#include "csr_graph.h"
 
 #include <fstream>
 #include <string>
@@ -10,6 +11,7 @@
 using std::ifstream;
 using std::string;
 using std::pair;
+using std::vector;
 
 /**
  * @brief 
@@ -22,7 +24,7 @@ void wasEntireGraphWasVisited(Graph* g, bool visited) {
     REQUIRE( e->wasExplored() == visited );
   }
 
-  for (pair<string, Vertex*> p : g->getVertices()) {
+  for (const pair<const Address, Vertex*>& p : g->getVertices()) {
     REQUIRE( p.second->wasExplored() == visited );
   }
 }
@@ -51,7 +53,7 @@ TEST_CASE("Simple BFS on graph with 1 connected component", "[bfs]") {
 
   wasEntireGraphWasVisited(&g, false);
 
-  int num_connected_components = bfs(&g);
+  int num_connected_components = bfs(&g, true);
   REQUIRE( num_connected_components == 1 );
 
   wasEntireGraphWasVisited(&g, true);
@@ -78,7 +80,7 @@ TEST_CASE("Simple BFS on graph with 2 connected components", "[bfs]") {
 
   wasEntireGraphWasVisited(&g, false);
 
-  int num_connected_components = bfs(&g);
+  int num_connected_components = bfs(&g, true);
   REQUIRE( num_connected_components == 2 );
 
   wasEntireGraphWasVisited(&g, true);
@@ -102,7 +104,7 @@ TEST_CASE("Simple BFS on graph with 4 connected components", "[bfs]") {
 
   wasEntireGraphWasVisited(&g, false);
 
-  int num_connected_components = bfs(&g);
+  int num_connected_components = bfs(&g, true);
   REQUIRE( num_connected_components == 4 );
 
   wasEntireGraphWasVisited(&g, true);
@@ -140,7 +142,7 @@ TEST_CASE("BFS on complex graph 1", "[bfs]") {
 
   wasEntireGraphWasVisited(&g, false);
 
-  int num_connected_components = bfs(&g);
+  int num_connected_components = bfs(&g, true);
   REQUIRE( num_connected_components == 1 );
 
   wasEntireGraphWasVisited(&g, true);
@@ -178,7 +180,7 @@ TEST_CASE("BFS on complex graph 2", "[bfs]") {
 
   wasEntireGraphWasVisited(&g, false);
 
-  int num_connected_components = bfs(&g);
+  int num_connected_components = bfs(&g, true);
   REQUIRE( num_connected_components == 1 );
 
   wasEntireGraphWasVisited(&g, true);
@@ -220,12 +222,78 @@ TEST_CASE("BFS on complex graph 3", "[bfs]") {
 
   wasEntireGraphWasVisited(&graph, false);
 
-  int num_connected_components = bfs(&graph);
+  int num_connected_components = bfs(&graph, true);
   REQUIRE( num_connected_components == 1 );
 
   wasEntireGraphWasVisited(&graph, true);
 }
 
+/**
+ * Traversal on the following graph, leaving the edges unmarked: 
+ *      
+ *      A ----- B       C
+ * 
+ */
+TEST_CASE("BFS only marks edges as explored when asked to", "[bfs]") {
+  Graph g;
+
+  Vertex* a = g.addVertex("0x1");
+  Vertex* b = g.addVertex("0x2");
+  Vertex* c = g.addVertex("0x3");
+
+  Edge* e = g.addEdge(a, b, 1, 1, 1);
+
+  REQUIRE( bfs(&g) == 2 );
+  REQUIRE( a->wasExplored() );
+  REQUIRE( b->wasExplored() );
+  REQUIRE( c->wasExplored() );
+  REQUIRE( !e->wasExplored() );
+}
+
+/**
+ * Traversal on a hub joined to 1000 leaves, each of which has a leaf of its 
+ * own, alongside 50 separate pairs and 5 isolated vertices. The two largest
+ * levels of the hub's component are expanded bottom-up.
+ */
+TEST_CASE("Direction-optimizing BFS on a graph with a hub", "[bfs]") {
+  Graph g;
+
+  Vertex* hub = g.addVertex("0x1");
+  for (int i = 0; i < 1000; ++i) {
+    Vertex* leaf = g.addVertex("0x1" + std::to_string(100000 + i));
+    Vertex* outer = g.addVertex("0x2" + std::to_string(100000 + i));
+    g.addEdge(hub, leaf, 1, 1, 1);
+    g.addEdge(leaf, outer, 1, 1, 1);
+  }
+
+  for (int i = 0; i < 50; ++i) {
+    g.addEdge(g.addVertex("0x3" + std::to_string(100000 + i)), 
+              g.addVertex("0x4" + std::to_string(100000 + i)), 1, 1, 1);
+  }
+
+  for (int i = 0; i < 5; ++i) {
+    g.addVertex("0x5" + std::to_string(100000 + i));
+  }
+
+  REQUIRE( find_largest_component(&g).size() == 2001 );
+  REQUIRE( find_largest_component(&g, g.getVertex("0x3100000")).size() == 2 );
+
+  CSRGraph csr(g);
+  REQUIRE( bfs(csr) == 56 );
+  REQUIRE( find_largest_component(csr).size() == 2001 );
+
+  vector<uint32_t> sizes;
+  vector<uint32_t> labels = label_components(csr, sizes);
+  REQUIRE( sizes.size() == 56 );
+  REQUIRE( sizes[labels[hub->getId()]] == 2001 );
+  REQUIRE( labels[g.getVertex("0x2100999")->getId()] == labels[hub->getId()] );
+  REQUIRE( sizes[labels[g.getVertex("0x4100049")->getId()]] == 2 );
+  REQUIRE( sizes[labels[g.getVertex("0x5100004")->getId()]] == 1 );
+
+  REQUIRE( bfs(&g, true) == 56 );
+  wasEntireGraphWasVisited(&g, true);
+}
+
 /**
  * Traversal on graph defined in data/10mb_data.csv.
  */
@@ -238,7 +306,7 @@ TEST_CASE("BFS on a large graph from a CSV file", "[bfs]") {
   Graph* graph = Graph::fromFile(path, true);
 
   wasEntireGraphWasVisited(graph, false);
-  int num_connected_components = bfs(graph);
+  int num_connected_components = bfs(graph, true);
   wasEntireGraphWasVisited(graph, true);
 
   delete graph;
@@ -256,7 +324,7 @@ TEST_CASE("BFS on a large graph from a CSV file 2", "[bfs]") {
   Graph* graph = Graph::fromFile(path, true);
 
   wasEntireGraphWasVisited(graph, false);
-  int num_connected_components = bfs(graph);
+  int num_connected_components = bfs(graph, true);
   wasEntireGraphWasVisited(graph, true);
 
   delete graph;
@@ -0,0 +1,164 @@
+#include "catch.hpp"
+#include "test_graphs.h"
+#include "test_files.h"
+#include "connected_components.h"
+#include "component_census.h"
+#include "csr_graph.h"
+#include "vertex.h"
+#include "graph.h"
+#include "bfs.h"
+
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <string>
+#include <vector>
+
+using std::string;
+using std::vector;
+
+TEST_CASE("Afforest finds the same components as BFS", "[components]") {
+  int num_threads = GENERATE(1, 4);
+
+  // about 1.2 edges per vertex leaves a giant component alongside thousands
+  // of small ones and isolated vertices
+  Graph g;
+  randomGraph(g, 20000, 12000, 20000, 1);
+
+  CSRGraph csr(g);
+  vector<uint32_t> sizes;
+  vector<uint32_t> labels = label_components(csr, sizes);
+
+  Components components = connected_components(csr, num_threads);
+
+  REQUIRE( components.labels == labels );
+  REQUIRE( components.sizes == sizes );
+  REQUIRE( components.sizes[components.largest] == 
+           find_largest_component(csr).size() );
+
+  vector<uint32_t> members = component_members(components, components.largest);
+  REQUIRE( members.size() == components.sizes[components.largest] );
+  for (uint32_t v : members) {
+    REQUIRE( components.labels[v] == components.largest );
+  }
+}
+
+TEST_CASE("Afforest on a graph with a hub and separate pairs", "[components]") {
+  int num_threads = GENERATE(1, 3);
+
+  Graph g;
+
+  // the pairs come first so the hub does not have the lowest ID
+  for (int i = 0; i < 100; ++i) {
+    g.addEdge(g.addVertex("0x1" + std::to_string(100000 + i)), 
+              g.addVertex("0x2" + std::to_string(100000 + i)), 1, 1, 1);
+  }
+
+  Vertex* hub = g.addVertex("0x3");
+  for (int i = 0; i < 5000; ++i) {
+    g.addEdge(g.addVertex("0x4" + std::to_string(100000 + i)), hub, 1, 1, 1);
+  }
+
+  g.addVertex("0x5");
+
+  CSRGraph csr(g);
+  Components components = connected_components(csr, num_threads);
+
+  REQUIRE( components.sizes.size() == 102 );
+  REQUIRE( components.largest == 100 );
+  REQUIRE( components.labels[hub->getId()] == 100 );
+  REQUIRE( components.sizes[100] == 5001 );
+  REQUIRE( components.labels[g.getVertex("0x5")->getId()] == 101 );
+
+  for (uint32_t c = 0; c < 100; ++c) {
+    REQUIRE( components.sizes[c] == 2 );
+  }
+}
+
+TEST_CASE("Afforest on a graph without vertices", "[components]") {
+  Graph g;
+  CSRGraph csr(g);
+  Components components = connected_components(csr, 2);
+
+  REQUIRE( components.labels.empty() );
+  REQUIRE( components.sizes.empty() );
+  REQUIRE( components.largest == Components::NO_COMPONENT );
+}
+
+TEST_CASE("Component census counts vertices, edges, gas, and value", "[components]") {
+  Graph g;
+
+  // a triangle, two pairs, and an isolated vertex
+  Vertex* a = g.addVertex("0x1");
+  Vertex* b = g.addVertex("0x2");
+  Vertex* c = g.addVertex("0x3");
+  g.addEdge(a, b, 1.5, 10, 1);
+  g.addEdge(b, c, 2.5, 20, 1);
+  g.addEdge(c, a, 0.5, 30, 1);
+
+  g.addEdge(g.addVertex("0x4"), g.addVertex("0x5"), 4, 7, 1);
+  g.addVertex("0x6");
+  g.addEdge(g.addVertex("0x7"), g.addVertex("0x8"), 1, 5, 1);
+  g.addEdge(g.getVertex("0x8"), g.getVertex("0x7"), 1, 5, 1);
+
+  CSRGraph csr(g);
+  Components components = connected_components(csr);
+  ComponentCensus census = ComponentCensus::take(g, components);
+
+  REQUIRE( census.numComponents() == 4 );
+  REQUIRE( census.numVertices(0) == 3 );
+  REQUIRE( census.numEdges(0) == 3 );
+  REQUIRE( census.totalGas(0) == 60 );
+  REQUIRE( census.totalValue(0) == 4.5 );
+  REQUIRE( census.numEdges(2) == 0 );
+  REQUIRE( census.numEdges(3) == 2 );
+  REQUIRE( census.totalGas(3) == 10 );
+
+  using Histogram = vector<std::pair<uint32_t, uint32_t>>;
+  REQUIRE( census.sizeHistogram() == Histogram({{1, 1}, {2, 2}, {3, 1}}) );
+  REQUIRE( census.largest(3) == vector<uint32_t>({0, 1, 3}) );
+  REQUIRE( census.largest(10).size() == 4 );
+
+  string path = "/tmp/graphthereum_census.bin";
+  REQUIRE( census.save(path) );
+
+  ComponentCensus loaded;
+  REQUIRE( ComponentCensus::load(path, loaded) );
+  REQUIRE( loaded.numComponents() == 4 );
+  for (uint32_t i = 0; i < 4; ++i) {
+    REQUIRE( loaded.numVertices(i) == census.numVertices(i) );
+    REQUIRE( loaded.numEdges(i) == census.numEdges(i) );
+    REQUIRE( loaded.totalGas(i) == census.totalGas(i) );
+    REQUIRE( loaded.totalValue(i) == census.totalValue(i) );
+  }
+
+  // a count too large for the file is rejected, even where its size in bytes
+  // overflows
+  overwriteAt<uint64_t>(path, offsetof(CensusHeader, num_components),
+                        uint64_t(1) << 62);
+  REQUIRE( !ComponentCensus::load(path, loaded) );
+
+  // as is a header size that overlaps the header or misaligns the arrays
+  REQUIRE( census.save(path) );
+  overwriteAt<uint32_t>(path, offsetof(CensusHeader, header_size), 0);
+  REQUIRE( !ComponentCensus::load(path, loaded) );
+  overwriteAt<uint32_t>(path, offsetof(CensusHeader, header_size),
+                        sizeof(CensusHeader) + 4);
+  REQUIRE( !ComponentCensus::load(path, loaded) );
+  std::remove(path.c_str());
+
+  // a CSV census is not a binary census
+  string csv_path = "/tmp/graphthereum_census.csv";
+  REQUIRE( census.saveCsv(csv_path) );
+  REQUIRE( !ComponentCensus::load(csv_path, loaded) );
+
+  std::ifstream csv(csv_path);
+  string header, first;
+  std::getline(csv, header);
+  std::getline(csv, first);
+  REQUIRE( header == "component,vertices,edges,total_gas,total_value" );
+  REQUIRE( first == "0,3,3,60,4.5" );
+
+  std::remove(path.c_str());
+  std::remove(csv_path.c_str());
+}
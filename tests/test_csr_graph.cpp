@@ -0,0 +1,279 @@
+#include "catch.hpp"
+#include "test_graphs.h"
+#include "betweenness.h"
+#include "dijkstras.h"
+#include "csr_graph.h"
+#include "workspace.h"
+#include "vertex.h"
+#include "graph.h"
+#include "edge.h"
+#include "subgraph_view.h"
+#include "bfs.h"
+
+#include <string>
+#include <vector>
+
+using std::vector;
+
+/**
+ * Construction of the following graph, with the gas of each edge shown:
+ *
+ *          1
+ *    A --------- B
+ *     \          |
+ *      \       2 |
+ *     4 \        |     3
+ *        ------- C --------- D          E
+ */
+TEST_CASE("CSRGraph mirrors the adjacency lists of a Graph", "[csr]") {
+  Graph g;
+
+  Vertex* a = g.addVertex("0x1");
+  Vertex* b = g.addVertex("0x2");
+  Vertex* c = g.addVertex("0x3");
+  Vertex* d = g.addVertex("0x4");
+  Vertex* e = g.addVertex("0x5");
+
+  g.addEdge(a, b, 1, 1, 2);
+  g.addEdge(a, c, 1, 4, 12);
+  g.addEdge(b, c, 1, 2, 3);
+  g.addEdge(c, d, 1, 3, 2);
+
+  CSRGraph csr(g);
+
+  REQUIRE( csr.numVertices() == 5 );
+  REQUIRE( csr.numEdges() == 4 );
+
+  for (uint32_t id = 0; id < csr.numVertices(); ++id) {
+    Vertex* v = g.getVertexById(id);
+    REQUIRE( v->getId() == id );
+    REQUIRE( csr.getAddress(id) == v->getAddress() );
+    REQUIRE( csr.degree(id) == v->getIncidentEdges().size() );
+
+    for (uint32_t i = 0; i < csr.degree(id); ++i) {
+      Edge* incident = v->getIncidentEdges()[i];
+      REQUIRE( csr.neighbor(csr.offset(id) + i) == incident->getAdjacentVertex(v)->getId() );
+      REQUIRE( csr.weight(csr.offset(id) + i) == incident->getGas() );
+    }
+  }
+
+  REQUIRE( csr.degree(e->getId()) == 0 );
+  REQUIRE( bfs(csr) == 2 );
+  REQUIRE( find_largest_component(csr).size() == 4 );
+
+  TraversalWorkspace workspace(csr);
+  dijkstra(csr, a->getId(), workspace);
+
+  REQUIRE( workspace.getDistance(b->getId()) == 1 );
+  REQUIRE( workspace.getDistance(c->getId()) == 3 );
+  REQUIRE( workspace.getDistance(d->getId()) == 6 );
+  REQUIRE( workspace.getDistance(e->getId()) == TraversalWorkspace::UNREACHED );
+  REQUIRE( workspace.getParent(d->getId()) == c->getId() );
+  REQUIRE( workspace.getParent(c->getId()) == b->getId() );
+}
+
+/**
+ * All Edge Weights are 1:
+ *
+ *     A ----- B ----- D
+ *     |         ____/ | \____
+ *     |        /      |      \
+ *     C ----- E ----- G ----- F
+ *                     |
+ *                     H
+ *
+ * Expected betweenness centrality matches the Graph based implementation.
+ */
+TEST_CASE("Betweenness centrality on a CSRGraph matches the Graph implementation", "[csr]") {
+  Graph graph;
+
+  Vertex* a = graph.addVertex("0x1");
+  Vertex* b = graph.addVertex("0x2");
+  Vertex* c = graph.addVertex("0x3");
+  Vertex* d = graph.addVertex("0x4");
+  Vertex* e = graph.addVertex("0x5");
+  Vertex* f = graph.addVertex("0x6");
+  Vertex* g = graph.addVertex("0x7");
+  Vertex* h = graph.addVertex("0x8");
+
+  graph.addEdge(a, b, 1, 1, 50);
+  graph.addEdge(a, c, 1, 1, 21);
+  graph.addEdge(b, d, 1, 1, 42);
+  graph.addEdge(c, e, 1, 1, 57);
+  graph.addEdge(d, e, 1, 1, 53);
+  graph.addEdge(d, f, 1, 1, 57);
+  graph.addEdge(d, g, 1, 1, 40);
+  graph.addEdge(e, g, 1, 1, 63);
+  graph.addEdge(f, g, 1, 1, 51);
+  graph.addEdge(g, h, 1, 1, 1);
+
+  CSRGraph csr(graph);
+  vector<double> sequential = compute_betweenness_centrality(csr);
+  vector<double> parallel = compute_betweenness_centrality(csr, 3);
+
+  REQUIRE( sequential[a->getId()] == 1.0 );
+  REQUIRE( sequential[b->getId()] == 3.0 );
+  REQUIRE( sequential[c->getId()] == 2.0 );
+  REQUIRE( sequential[d->getId()] == 7.0 );
+  REQUIRE( sequential[e->getId()] == 5.0 );
+  REQUIRE( sequential[f->getId()] == 0.0 );
+  REQUIRE( sequential[g->getId()] == 7.0 );
+  REQUIRE( sequential[h->getId()] == 0.0 );
+
+  for (uint32_t id = 0; id < csr.numVertices(); ++id) {
+    REQUIRE( parallel[id] == Approx(sequential[id]) );
+  }
+}
+
+/**
+ * Weighted graph where a shorter path to a vertex is found after a longer one
+ * has already been recorded:
+ *
+ *          1         1
+ *    A --------- B ------ D
+ *    |                    |
+ *    | 1                  | 1
+ *    |         5          |
+ *    C ------------------ E
+ *
+ * From A, E is first reached through C with distance 6, then through D with 
+ * distance 3. Only the path through D is a shortest path.
+ */
+TEST_CASE("Betweenness centrality on a CSRGraph discards paths that stop being shortest", "[csr]") {
+  Graph graph;
+
+  Vertex* a = graph.addVertex("0x1");
+  Vertex* b = graph.addVertex("0x2");
+  Vertex* c = graph.addVertex("0x3");
+  Vertex* d = graph.addVertex("0x4");
+  Vertex* e = graph.addVertex("0x5");
+
+  graph.addEdge(a, b, 1, 1, 1);
+  graph.addEdge(a, c, 1, 1, 1);
+  graph.addEdge(b, d, 1, 1, 1);
+  graph.addEdge(c, e, 1, 5, 1);
+  graph.addEdge(d, e, 1, 1, 1);
+
+  CSRGraph csr(graph);
+  TraversalWorkspace workspace(csr);
+  dijkstra(csr, a->getId(), workspace);
+
+  REQUIRE( workspace.getDistance(e->getId()) == 3 );
+  REQUIRE( workspace.getPathCount(e->getId()) == 1.0 );
+  REQUIRE( workspace.predecessorsEnd(e->getId()) - workspace.predecessorsBegin(e->getId()) == 1 );
+  REQUIRE( *workspace.predecessorsBegin(e->getId()) == d->getId() );
+}
+
+TEST_CASE("Betweenness centrality on a CSRGraph counts the shortest paths", "[csr]") {
+  int num_threads = GENERATE(1, 3);
+
+  // a square A - B - C - D - A has one shortest path between each of the 4
+  // adjacent pairs and two between each of the 2 opposite pairs, and a tail
+  // E off of A adds 1 + 2 + 1 + 1 paths from E
+  Graph g;
+  addVertices(g, 5);
+  for (uint32_t i = 0; i < 4; ++i) {
+    g.addEdge(g.getVertexById(i), g.getVertexById((i + 1) % 4), 1, 1, 1);
+  }
+  g.addEdge(g.getVertexById(0), g.getVertexById(4), 1, 1, 1);
+
+  CSRGraph csr(g);
+  double num_shortest_paths = 0.0;
+  compute_betweenness_centrality(csr, num_threads, false, QueueType::AUTO,
+                                 &num_shortest_paths);
+
+  REQUIRE( num_shortest_paths == 4 + 2 * 2 + 5 );
+}
+
+TEST_CASE("TraversalWorkspace forgets the previous search after a reset", "[csr]") {
+  Graph g;
+
+  Vertex* a = g.addVertex("0x1");
+  Vertex* b = g.addVertex("0x2");
+  Vertex* c = g.addVertex("0x3");
+  Vertex* d = g.addVertex("0x4");
+
+  g.addEdge(a, b, 1, 1, 1);
+  g.addEdge(b, c, 1, 1, 1);
+
+  CSRGraph csr(g);
+  TraversalWorkspace workspace(csr);
+
+  dijkstra(csr, a->getId(), workspace);
+  REQUIRE( workspace.getDistance(c->getId()) == 2 );
+  REQUIRE( workspace.getSettledOrder().size() == 3 );
+
+  // d is isolated, so every vertex but d must read as unreached
+  dijkstra(csr, d->getId(), workspace);
+  REQUIRE( workspace.getSettledOrder().size() == 1 );
+
+  for (Vertex* v : {a, b, c}) {
+    REQUIRE( workspace.getDistance(v->getId()) == TraversalWorkspace::UNREACHED );
+    REQUIRE( workspace.getParent(v->getId()) == TraversalWorkspace::NO_VERTEX );
+    REQUIRE( workspace.getPathCount(v->getId()) == 0.0 );
+    REQUIRE( workspace.getDependency(v->getId()) == 0.0 );
+    REQUIRE( !workspace.wasExplored(v->getId()) );
+    REQUIRE( workspace.predecessorsBegin(v->getId()) == workspace.predecessorsEnd(v->getId()) );
+  }
+
+  REQUIRE( workspace.getDistance(d->getId()) == 0 );
+}
+
+TEST_CASE("A subgraph view matches the subgraph it induces", "[csr]") {
+  int num_threads = GENERATE(1, 4);
+
+  Graph g;
+  randomGraph(g, 3000, 6000, 3000, 50);
+
+  CSRGraph csr(g);
+
+  // every third vertex, listed out of order and with duplicates
+  vector<uint32_t> vertices;
+  for (uint32_t v = 2999; v < 3000; v -= 3) vertices.push_back(v);
+  vertices.push_back(2999);
+
+  SubgraphView view(csr.numVertices(), vertices);
+  REQUIRE( view.numVertices() == 1000 );
+  REQUIRE( view.numParentVertices() == 3000 );
+
+  for (uint32_t v = 0; v < csr.numVertices(); ++v) {
+    REQUIRE( view.contains(v) == (v % 3 == 2) );
+    REQUIRE( view.toLocal(v) == 
+             (v % 3 == 2 ? v / 3 : SubgraphView::NO_VERTEX) );
+  }
+
+  for (uint32_t v = 0; v < view.numVertices(); ++v) {
+    REQUIRE( view.toLocal(view.toParent(v)) == v );
+  }
+
+  CSRGraph subgraph = view.materialize(csr, num_threads);
+  REQUIRE( subgraph.numVertices() == view.numVertices() );
+  REQUIRE( subgraph.numEdges() == view.countEdges(csr) );
+
+  for (uint32_t v = 0; v < subgraph.numVertices(); ++v) {
+    uint32_t p = view.toParent(v);
+    REQUIRE( subgraph.getAddress(v) == csr.getAddress(p) );
+
+    // neighbors keep their order in the parent, minus those outside the view
+    uint64_t next = subgraph.offset(v);
+    for (uint64_t i = csr.offset(p); i < csr.offset(p + 1); ++i) {
+      if (!view.contains(csr.neighbor(i))) continue;
+
+      REQUIRE( subgraph.neighbor(next) == view.toLocal(csr.neighbor(i)) );
+      REQUIRE( subgraph.weight(next) == csr.weight(i) );
+      ++next;
+    }
+
+    REQUIRE( next == subgraph.offset(v + 1) );
+  }
+
+  REQUIRE( bfs(csr, view) == bfs(subgraph) );
+
+  // a view of every vertex sees the whole graph
+  vector<uint32_t> all(csr.numVertices());
+  for (uint32_t v = 0; v < csr.numVertices(); ++v) all[v] = v;
+
+  SubgraphView whole(csr.numVertices(), all);
+  REQUIRE( whole.countEdges(csr) == csr.numEdges() );
+  REQUIRE( bfs(csr, whole) == bfs(csr) );
+}
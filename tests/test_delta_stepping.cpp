@@ -0,0 +1,84 @@
+#include "catch.hpp"
+#include "test_graphs.h"
+#include "delta_stepping.h"
+#include "thread_pool.h"
+#include "dijkstras.h"
+#include "csr_graph.h"
+#include "workspace.h"
+#include "vertex.h"
+#include "graph.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+using std::vector;
+
+TEST_CASE("ThreadPool runs every task exactly once", "[delta]") {
+  int num_threads = GENERATE(1, 4);
+  ThreadPool pool(num_threads);
+
+  REQUIRE( pool.size() == num_threads );
+
+  for (size_t num_tasks : {0, 1, 7, 1000}) {
+    vector<int> runs(num_tasks, 0);
+    vector<int> thread_of(num_tasks, -1);
+
+    pool.parallelFor(num_tasks, [&](size_t task, int thread) {
+      ++runs[task];
+      thread_of[task] = thread;
+    });
+
+    for (size_t i = 0; i < num_tasks; ++i) {
+      REQUIRE( runs[i] == 1 );
+      REQUIRE( thread_of[i] >= 0 );
+      REQUIRE( thread_of[i] < num_threads );
+    }
+  }
+}
+
+TEST_CASE("ThreadPool covers a range with blocks that do not overlap", "[delta]") {
+  int num_threads = GENERATE(1, 4);
+  ThreadPool pool(num_threads);
+
+  for (size_t n : {0, 1, 255, 256, 257, 10000}) {
+    vector<int> runs(n, 0);
+    vector<size_t> block_ends(n, 0);
+
+    // blocks are checked once the loop is done, off the pool's threads
+    pool.parallelForRange(n, 256, [&](size_t begin, size_t end, int thread) {
+      for (size_t i = begin; i < end; ++i) {
+        ++runs[i];
+        block_ends[i] = end;
+      }
+    });
+
+    for (size_t i = 0; i < n; ++i) {
+      REQUIRE( runs[i] == 1 );
+      REQUIRE( block_ends[i] == std::min<size_t>(n, i / 256 * 256 + 256) );
+    }
+  }
+}
+
+TEST_CASE("Delta-stepping finds the same distances as Dijkstra's algorithm", "[delta]") {
+  int num_threads = GENERATE(1, 3);
+  uint64_t delta = GENERATE(as<uint64_t>(), 0, 1, 7, 1000000);
+
+  // leave a few vertices unreachable
+  Graph g;
+  randomGraph(g, 2000, 5000, 1990, 49, 0);
+
+  CSRGraph csr(g);
+  TraversalWorkspace workspace(csr);
+  ThreadPool pool(num_threads);
+
+  for (uint32_t source : {0u, 1234u, 1995u}) {
+    dijkstra(csr, source, workspace);
+    vector<uint64_t> distances = delta_stepping(csr, source, delta, pool);
+
+    REQUIRE( distances.size() == csr.numVertices() );
+    for (uint32_t v = 0; v < csr.numVertices(); ++v) {
+      REQUIRE( distances[v] == workspace.getDistance(v) );
+    }
+  }
+}
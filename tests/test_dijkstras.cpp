@@ -1,11 +1,16 @@
 #include "catch.hpp"
+#include "test_graphs.h"
+#include "indexed_heap.h"
 #include "dijkstras.h"
+#include "csr_graph.h"
+#include "workspace.h"
 #include "vertex.h"
 #include "graph.h"
 #include "edge.h"
 #include "bfs.h"
 
 #include <unordered_map>
+#include <algorithm>
 #include <string>
 #include <vector>
 
@@ -223,3 +228,190 @@ TEST_CASE("Complex Dijkstra's Algorithm - single connected component with differ
 
   verifyShortestPathsAndDistances(graph, distances, paths);
 }
+
+TEST_CASE("IndexedHeap pops vertices in order of their lowest distance", "[dijkstras]") {
+  IndexedHeap heap(10);
+
+  uint64_t distances[] = {50, 20, 90, 40, 70, 10, 80, 30, 60, 100};
+  for (uint32_t v = 0; v < 10; ++v) {
+    heap.pushOrDecrease(v, distances[v]);
+  }
+
+  // lowering a key moves the vertex instead of adding a second entry
+  heap.pushOrDecrease(9, 5);
+  heap.pushOrDecrease(2, 15);
+  // raising a key is ignored
+  heap.pushOrDecrease(5, 1000);
+
+  REQUIRE( heap.size() == 10 );
+
+  vector<uint32_t> order;
+  while (!heap.empty()) {
+    order.push_back(heap.top().second);
+    REQUIRE( !heap.contains(9) == (order.size() > 1) );
+    heap.pop();
+  }
+
+  REQUIRE( order == vector<uint32_t>{9, 5, 2, 1, 7, 3, 0, 8, 4, 6} );
+  REQUIRE( !heap.contains(0) );
+}
+
+/**
+ * @brief Get the sorted predecessors of every vertex after a search on a 
+ * CSRGraph.
+ */
+vector<vector<uint32_t>> sortedPredecessors(const TraversalWorkspace& workspace) {
+  vector<vector<uint32_t>> predecessors(workspace.size());
+
+  for (uint32_t v = 0; v < workspace.size(); ++v) {
+    predecessors[v].assign(workspace.predecessorsBegin(v), 
+                           workspace.predecessorsEnd(v));
+    std::sort(predecessors[v].begin(), predecessors[v].end());
+  }
+
+  return predecessors;
+}
+
+TEST_CASE("Dijkstra's Algorithm gives the same results with every queue", "[dijkstras]") {
+  // small weights produce many ties between shortest paths and are searched 
+  // with a bucket queue by default, large weights with a radix heap. Weights
+  // are positive, since with zero weight edges the number of shortest paths
+  // depends on the order in which vertices at the same distance are settled.
+  uint64_t max_weight = GENERATE(as<uint64_t>(), 8, 100000000);
+
+  Graph g;
+  randomGraph(g, 500, 2000, 500, max_weight);
+
+  CSRGraph csr(g);
+  TraversalWorkspace expected(csr), actual(csr);
+
+  for (uint32_t source = 0; source < 500; source += 50) {
+    dijkstra(csr, source, expected, QueueType::LAZY_BINARY_HEAP);
+    dijkstra(&g, g.getVertexById(source));
+
+    for (uint32_t v = 0; v < csr.numVertices(); ++v) {
+      REQUIRE( expected.getDistance(v) == g.getVertexById(v)->getDistance() );
+    }
+
+    for (QueueType queue : {QueueType::INDEXED_HEAP, QueueType::RADIX_HEAP, 
+                            QueueType::BUCKET_QUEUE, QueueType::AUTO}) {
+      dijkstra(csr, source, actual, queue);
+
+      for (uint32_t v = 0; v < csr.numVertices(); ++v) {
+        REQUIRE( actual.getDistance(v) == expected.getDistance(v) );
+        REQUIRE( actual.getPathCount(v) == expected.getPathCount(v) );
+      }
+
+      REQUIRE( sortedPredecessors(actual) == sortedPredecessors(expected) );
+    }
+  }
+}
+
+TEST_CASE("Bounded Dijkstra's Algorithm stops at a radius, a count, or its targets", "[dijkstras]") {
+  Graph g;
+  randomGraph(g, 500, 2000, 500, 100);
+
+  CSRGraph csr(g);
+  TraversalWorkspace full(csr), bounded(csr);
+  dijkstra(csr, 7, full);
+
+  QueueType queue = GENERATE(QueueType::LAZY_BINARY_HEAP, 
+                             QueueType::INDEXED_HEAP, QueueType::AUTO);
+
+  SECTION("radius") {
+    SearchLimits limits;
+    limits.max_distance = 60;
+    bounded_dijkstra(csr, 7, bounded, limits, queue);
+
+    size_t within = 0;
+    for (uint32_t v = 0; v < csr.numVertices(); ++v) {
+      if (full.getDistance(v) <= 60) ++within;
+    }
+
+    REQUIRE( bounded.getSettledOrder().size() == within );
+    for (uint32_t v : bounded.getSettledOrder()) {
+      REQUIRE( bounded.getDistance(v) == full.getDistance(v) );
+      REQUIRE( bounded.getDistance(v) <= 60 );
+    }
+  }
+
+  SECTION("nearest") {
+    SearchLimits limits;
+    limits.max_settled = 25;
+    bounded_dijkstra(csr, 7, bounded, limits, queue);
+
+    const vector<uint32_t>& settled = bounded.getSettledOrder();
+    REQUIRE( settled.size() == 25 );
+
+    for (size_t i = 0; i < settled.size(); ++i) {
+      REQUIRE( bounded.getDistance(settled[i]) == 
+               full.getDistance(full.getSettledOrder()[i]) );
+    }
+  }
+
+  SECTION("targets") {
+    SearchLimits limits;
+    limits.targets = {7, 42, 300, 42};
+    bounded_dijkstra(csr, 7, bounded, limits, queue);
+
+    for (uint32_t target : limits.targets) {
+      REQUIRE( bounded.wasExplored(target) );
+      REQUIRE( bounded.getDistance(target) == full.getDistance(target) );
+    }
+
+    REQUIRE( bounded.getSettledOrder().back() == 
+             (full.getDistance(42) > full.getDistance(300) ? 42u : 300u) );
+  }
+
+  // a later unbounded search on the same workspace is unaffected
+  dijkstra(csr, 7, bounded, queue);
+  for (uint32_t v = 0; v < csr.numVertices(); ++v) {
+    REQUIRE( bounded.getDistance(v) == full.getDistance(v) );
+  }
+}
+
+TEST_CASE("Multi-source Dijkstra's Algorithm finds the distance to the closest source", "[dijkstras]") {
+  // the last 10 vertices are left unreachable
+  Graph g;
+  randomGraph(g, 500, 2000, 490, 100);
+
+  CSRGraph csr(g);
+  vector<uint32_t> sources = {3, 150, 151, 420, 3};
+
+  // the smallest distance from any single source search
+  vector<uint64_t> expected(csr.numVertices(), TraversalWorkspace::UNREACHED);
+  TraversalWorkspace single(csr);
+
+  for (uint32_t source : sources) {
+    dijkstra(csr, source, single);
+
+    for (uint32_t v = 0; v < csr.numVertices(); ++v) {
+      expected[v] = std::min(expected[v], single.getDistance(v));
+    }
+  }
+
+  TraversalWorkspace workspace(csr);
+  vector<uint32_t> nearest_source;
+  multi_source_dijkstra(csr, sources, workspace, nearest_source);
+
+  REQUIRE( nearest_source.size() == csr.numVertices() );
+
+  for (uint32_t v = 0; v < csr.numVertices(); ++v) {
+    REQUIRE( workspace.getDistance(v) == expected[v] );
+
+    if (expected[v] == TraversalWorkspace::UNREACHED) {
+      REQUIRE( nearest_source[v] == TraversalWorkspace::NO_VERTEX );
+    } else {
+      REQUIRE( std::find(sources.begin(), sources.end(), nearest_source[v]) 
+               != sources.end() );
+
+      dijkstra(csr, nearest_source[v], single);
+      REQUIRE( single.getDistance(v) == expected[v] );
+    }
+  }
+
+  for (uint32_t source : sources) {
+    REQUIRE( workspace.getDistance(source) == 0 );
+    REQUIRE( nearest_source[source] == source );
+  }
+}
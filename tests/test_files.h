@@ -0,0 +1,37 @@
+#pragma once
+#include <cstddef>
+#include <fstream>
+#include <string>
+
+/**
+ * @brief Overwrite the bytes at the passed offset of the passed file with the
+ * passed value, in the byte order of this machine. Used to corrupt files the
+ * loaders must reject.
+ *
+ * @param path a std::string indicating the path of the file.
+ * @param offset a size_t indicating where to write the value.
+ * @param value the value to write.
+ */
+template <typename T>
+inline void overwriteAt(const std::string& path, size_t offset, T value) {
+  std::fstream f(path, std::ios::binary | std::ios::in | std::ios::out);
+  f.seekp(offset);
+  f.write(reinterpret_cast<const char*>(&value), sizeof(value));
+}
+
+/**
+ * @brief Read a value from the bytes at the passed offset of the passed file,
+ * in the byte order of this machine. Used to find the bytes to corrupt.
+ *
+ * @param path a std::string indicating the path of the file.
+ * @param offset a size_t indicating where the value is.
+ * @return the value read.
+ */
+template <typename T>
+inline T readAt(const std::string& path, size_t offset) {
+  T value = T();
+  std::ifstream f(path, std::ios::binary);
+  f.seekg(offset);
+  f.read(reinterpret_cast<char*>(&value), sizeof(value));
+  return value;
+}
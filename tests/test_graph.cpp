@@ -0,0 +1,457 @@
+#include "catch.hpp"
+#include "test_graphs.h"
+#include "test_files.h"
+#include "address.h"
+#include "snapshot.h"
+#include "vertex.h"
+#include "graph.h"
+#include "edge.h"
+
+#include <cstddef>
+#include <cstring>
+#include <cstdio>
+#include <fstream>
+#include <string>
+
+using std::ofstream;
+using std::string;
+
+/**
+ * @brief Write the given contents to a temporary CSV file and return the path
+ * to the file.
+ *
+ * @param name a string used to name the temporary file.
+ * @param contents a string containing the contents of the CSV file.
+ * @return a string indicating the path to the temporary file.
+ */
+string writeTemporaryCsv(const string& name, const string& contents) {
+  string path = "/tmp/graphthereum_" + name + ".csv";
+  ofstream of(path, std::ios::binary);
+  of << contents;
+  return path;
+}
+
+TEST_CASE("Loading a graph from a CSV file", "[graph]") {
+  string path = writeTemporaryCsv("load",
+    ",from_address,to_address,truncated_value,gas,gas_price\n"
+    "0,0xaa,0xbb,1.5,21000,2000000000\n"
+    "1,0xbb,0xcc,0.25,50000,3000000000\n"
+    "2,0xaa,0xcc,10,21000,1000000000\n"
+  );
+
+  Graph* g = Graph::fromFile(path, true);
+
+  REQUIRE( g->getVertices().size() == 3 );
+  REQUIRE( g->getEdges().size() == 3 );
+
+  Edge* e = g->getEdges()[1];
+  REQUIRE( e->getSource() == g->getVertex("0xbb") );
+  REQUIRE( e->getDestination() == g->getVertex("0xcc") );
+  REQUIRE( e->getValue() == 0.25 );
+  REQUIRE( e->getGas() == 50000 );
+  REQUIRE( e->getGasPrice() == 3000000000 );
+
+  REQUIRE( g->getVertex("0xaa")->getIncidentEdges().size() == 2 );
+  REQUIRE( g->getVertex("0xbb")->getIncidentEdges().size() == 2 );
+  REQUIRE( g->getVertex("0xcc")->getIncidentEdges().size() == 2 );
+
+  delete g;
+  std::remove(path.c_str());
+}
+
+TEST_CASE("Loading a graph from a CSV file with CRLF line endings and no trailing newline", "[graph]") {
+  string path = writeTemporaryCsv("crlf",
+    ",from_address,to_address,truncated_value,gas,gas_price\r\n"
+    "0,0xaa,0xbb,1.5,21000,7\r\n"
+    "1,0xbb,0xcc,2.5,21000,8"
+  );
+
+  Graph* g = Graph::fromFile(path, true);
+
+  REQUIRE( g->getVertices().size() == 3 );
+  REQUIRE( g->getEdges().size() == 2 );
+  REQUIRE( g->getEdges()[0]->getGasPrice() == 7 );
+  REQUIRE( g->getEdges()[1]->getGasPrice() == 8 );
+
+  delete g;
+  std::remove(path.c_str());
+}
+
+TEST_CASE("Loading a graph from a CSV file skips malformed records", "[graph]") {
+  string path = writeTemporaryCsv("malformed",
+    ",from_address,to_address,truncated_value,gas,gas_price\n"
+    "0,0xaa,0xbb,1.5,21000,7\n"
+    "1,0xbb,0xcc,not_a_number,21000,8\n"
+    "\n"
+    "2,0xcc\n"
+    "3,0xcc,0xdd,2,21000,9\n"
+    "4,0xdd,0xee, 1.5,21000,9\n"
+    "5,0xdd,0xee,1.5x,21000,9\n"
+    "6,0xdd,0xee,1.5,18446744073709551616,9\n"
+    "7,0xdd,0xee,1.5,-1,9\n"
+    "8,0xdd,0xff,2.5e-3,18446744073709551615,9\n"
+  );
+
+  Graph* g = Graph::fromFile(path, true);
+
+  REQUIRE( g->getEdges().size() == 3 );
+  REQUIRE( g->containsVertex("0xdd") );
+  REQUIRE( !g->containsVertex("0xee") );
+  REQUIRE( g->getEdges()[2]->getValue() == 2.5e-3 );
+  REQUIRE( g->getEdges()[2]->getGas() == UINT64_MAX );
+
+  delete g;
+  std::remove(path.c_str());
+}
+
+TEST_CASE("Loading a graph from a missing CSV file produces an empty graph", "[graph]") {
+  Graph* g = Graph::fromFile("/tmp/graphthereum_does_not_exist.csv", true);
+
+  REQUIRE( g->getVertices().size() == 0 );
+  REQUIRE( g->getEdges().size() == 0 );
+
+  delete g;
+}
+
+TEST_CASE("Loading a graph from a CSV file on multiple threads matches a single threaded load", "[graph]") {
+  string contents = ",from_address,to_address,truncated_value,gas,gas_price\n";
+  for (int i = 0; i < 500; ++i) {
+    contents += std::to_string(i) + ",0x" + std::to_string(i % 37) + ",0x" 
+              + std::to_string((i * 7) % 53) + "," + std::to_string(i) + ".5," 
+              + std::to_string(21000 + i) + ",1\n";
+  }
+
+  string path = writeTemporaryCsv("parallel", contents);
+
+  Graph* sequential = Graph::fromFile(path, true, 1);
+  Graph* parallel = Graph::fromFile(path, true, 7);
+
+  REQUIRE( sequential->getVertices().size() == parallel->getVertices().size() );
+  REQUIRE( sequential->getEdges().size() == 500 );
+  REQUIRE( parallel->getEdges().size() == 500 );
+
+  for (size_t i = 0; i < sequential->getEdges().size(); ++i) {
+    Edge* expected = sequential->getEdges()[i];
+    Edge* actual = parallel->getEdges()[i];
+
+    REQUIRE( expected->getSource()->getAddress() == actual->getSource()->getAddress() );
+    REQUIRE( expected->getDestination()->getAddress() == actual->getDestination()->getAddress() );
+    REQUIRE( expected->getValue() == actual->getValue() );
+    REQUIRE( expected->getGas() == actual->getGas() );
+  }
+
+  delete sequential;
+  delete parallel;
+  std::remove(path.c_str());
+}
+
+TEST_CASE("Saving and loading a graph snapshot restores the same graph", "[graph]") {
+  Graph g;
+
+  Vertex* a = g.addVertex("0xaa");
+  Vertex* b = g.addVertex("0xbb");
+  Vertex* c = g.addVertex("0xcc");
+  Vertex* d = g.addVertex("0xdd"); // isolated vertex
+
+  g.addEdge(a, b, 1.5, 21000, 7);
+  g.addEdge(b, c, 0.25, 50000, 8);
+  g.addEdge(c, a, 3, 60000, 9);
+
+  string path = "/tmp/graphthereum_snapshot.bin";
+  REQUIRE( g.toSnapshot(path) );
+
+  Graph* loaded = Graph::fromSnapshot(path, true);
+
+  REQUIRE( loaded->getVertices().size() == 4 );
+  REQUIRE( loaded->getEdges().size() == 3 );
+  REQUIRE( loaded->containsVertex("0xdd") );
+
+  for (size_t i = 0; i < g.getEdges().size(); ++i) {
+    Edge* expected = g.getEdges()[i];
+    Edge* actual = loaded->getEdges()[i];
+
+    REQUIRE( expected->getSource()->getAddress() == actual->getSource()->getAddress() );
+    REQUIRE( expected->getDestination()->getAddress() == actual->getDestination()->getAddress() );
+    REQUIRE( expected->getValue() == actual->getValue() );
+    REQUIRE( expected->getGas() == actual->getGas() );
+    REQUIRE( expected->getGasPrice() == actual->getGasPrice() );
+  }
+
+  const std::vector<Edge*>& incident = loaded->getVertex("0xaa")->getIncidentEdges();
+  REQUIRE( incident.size() == 2 );
+  REQUIRE( incident[0] == loaded->getEdges()[0] );
+  REQUIRE( incident[1] == loaded->getEdges()[2] );
+
+  delete loaded;
+  std::remove(path.c_str());
+}
+
+TEST_CASE("Loading a file that is not a graph snapshot produces an empty graph", "[graph]") {
+  string path = writeTemporaryCsv("not_a_snapshot",
+    ",from_address,to_address,truncated_value,gas,gas_price\n"
+    "0,0xaa,0xbb,1.5,21000,7\n"
+  );
+
+  Graph* g = Graph::fromSnapshot(path, true);
+  REQUIRE( g->getVertices().size() == 0 );
+
+  delete g;
+  std::remove(path.c_str());
+}
+
+TEST_CASE("Loading a corrupt graph snapshot produces an empty graph", "[graph]") {
+  Graph g;
+
+  Vertex* a = g.addVertex("0xaa");
+  Vertex* b = g.addVertex("0xbb");
+  Vertex* c = g.addVertex("0xcc");
+
+  g.addEdge(a, b, 1.5, 21000, 7);
+  g.addEdge(b, c, 0.25, 50000, 8);
+
+  string path = "/tmp/graphthereum_corrupt_snapshot.bin";
+  size_t adjacency_offsets = sizeof(SnapshotHeader)
+    + snapshot_align(3 * Address::SIZE);
+
+  SECTION("an adjacency offset far past the end of the adjacency") {
+    REQUIRE( g.toSnapshot(path) );
+    overwriteAt<uint64_t>(path, adjacency_offsets + 8, uint64_t(1) << 60);
+  }
+
+  SECTION("adjacency offsets that decrease") {
+    REQUIRE( g.toSnapshot(path) );
+    overwriteAt<uint64_t>(path, adjacency_offsets + 16, 0);
+  }
+
+  SECTION("adjacency offsets that do not end at twice the number of edges") {
+    REQUIRE( g.toSnapshot(path) );
+    overwriteAt<uint64_t>(path, adjacency_offsets + 24, 2);
+  }
+
+  SECTION("a header size that is not aligned") {
+    REQUIRE( g.toSnapshot(path) );
+    overwriteAt<uint32_t>(path, offsetof(SnapshotHeader, header_size),
+                          sizeof(SnapshotHeader) + 4);
+  }
+
+  SECTION("a header size smaller than the header") {
+    REQUIRE( g.toSnapshot(path) );
+    overwriteAt<uint32_t>(path, offsetof(SnapshotHeader, header_size), 0);
+  }
+
+  SECTION("an array count that overflows its size in bytes") {
+    REQUIRE( g.toSnapshot(path) );
+    overwriteAt<uint64_t>(path, offsetof(SnapshotHeader, num_edges),
+                          uint64_t(1) << 62);
+  }
+
+  Graph* loaded = Graph::fromSnapshot(path, true);
+  REQUIRE( loaded->getVertices().size() == 0 );
+  REQUIRE( loaded->getEdges().size() == 0 );
+
+  delete loaded;
+  std::remove(path.c_str());
+}
+
+/**
+ * @brief Write a version 1 snapshot of a graph with the two vertices 0xaa and
+ * 0xbb joined by one edge, storing addresses at the passed offsets.
+ */
+void writeVersion1Snapshot(const string& path,
+                           const std::vector<uint64_t>& address_offsets) {
+  std::ofstream of(path, std::ios::binary | std::ios::trunc);
+  string chars = "0xaa0xbb";
+
+  SnapshotHeader header;
+  memset(&header, 0, sizeof(header));
+  memcpy(header.magic, SNAPSHOT_MAGIC, sizeof(header.magic));
+  header.version = 1;
+  header.header_size = sizeof(SnapshotHeader);
+  header.num_vertices = 2;
+  header.num_edges = 1;
+  header.address_bytes = chars.size();
+
+  of.write(reinterpret_cast<const char*>(&header), sizeof(header));
+  snapshot_write_array(of, address_offsets);
+  snapshot_write_array(of, std::vector<char>(chars.begin(), chars.end()));
+  snapshot_write_array(of, std::vector<uint64_t>{0, 1, 2});
+  snapshot_write_array(of, std::vector<uint32_t>{0, 0});
+  snapshot_write_array(of, std::vector<uint32_t>{0});
+  snapshot_write_array(of, std::vector<uint32_t>{1});
+  snapshot_write_array(of, std::vector<double>{1.5});
+  snapshot_write_array(of, std::vector<uint64_t>{21000});
+  snapshot_write_array(of, std::vector<uint64_t>{7});
+}
+
+TEST_CASE("Loading a version 1 graph snapshot checks its address offsets", "[graph]") {
+  string path = "/tmp/graphthereum_version1_snapshot.bin";
+
+  writeVersion1Snapshot(path, {0, 4, 8});
+  Graph* loaded = Graph::fromSnapshot(path, true);
+  REQUIRE( loaded->getVertices().size() == 2 );
+  REQUIRE( loaded->containsVertex("0xbb") );
+  delete loaded;
+
+  for (const std::vector<uint64_t>& offsets : {
+         std::vector<uint64_t>{0, uint64_t(1) << 60, 8},
+         std::vector<uint64_t>{4, 4, 8},
+         std::vector<uint64_t>{0, 4, 6}}) {
+    writeVersion1Snapshot(path, offsets);
+    loaded = Graph::fromSnapshot(path, true);
+    REQUIRE( loaded->getVertices().size() == 0 );
+    delete loaded;
+  }
+
+  std::remove(path.c_str());
+}
+
+TEST_CASE("Addresses round trip between hexadecimal and binary form", "[graph]") {
+  Address address;
+  string hex = "0x1c39ba39e4735cb65978d4db400ddd70a72dc750";
+
+  REQUIRE( Address::fromHex(hex, address) );
+  REQUIRE( address.toHex() == hex );
+
+  Address uppercase;
+  REQUIRE( Address::fromHex("0x1C39BA39E4735CB65978D4DB400DDD70A72DC750", uppercase) );
+  REQUIRE( uppercase == address );
+
+  Address short_address;
+  REQUIRE( Address::fromHex("0x1", short_address) );
+  REQUIRE( short_address.toHex() == "0x0000000000000000000000000000000000000001" );
+  REQUIRE( short_address != address );
+  REQUIRE( AddressHash()(short_address) != AddressHash()(Address()) );
+
+  Address invalid = address;
+  REQUIRE_FALSE( Address::fromHex("0x", invalid) );
+  REQUIRE_FALSE( Address::fromHex("0xzz", invalid) );
+  REQUIRE_FALSE( Address::fromHex(hex + "0", invalid) );
+  REQUIRE( invalid == address );
+}
+
+TEST_CASE("Vertices can be looked up by hexadecimal or binary address", "[graph]") {
+  Graph g;
+
+  Vertex* a = g.addVertex("0x1c39ba39e4735cb65978d4db400ddd70a72dc750");
+  REQUIRE( g.addVertex("not an address") == NULL );
+
+  Address address;
+  REQUIRE( Address::fromHex("0x1c39ba39e4735cb65978d4db400ddd70a72dc750", address) );
+
+  REQUIRE( g.getVertex(address) == a );
+  REQUIRE( g.getVertex("0x1C39BA39E4735CB65978D4DB400DDD70A72DC750") == a );
+  REQUIRE( g.containsVertex(address) );
+  REQUIRE_FALSE( g.containsVertex("0x2") );
+  REQUIRE( g.getVertex("not an address") == NULL );
+}
+
+TEST_CASE("Copying a graph keeps vertex IDs, edge order, and adjacency order", "[graph]") {
+  Graph original;
+
+  // add more vertices than fit in one arena block
+  addVertices(original, 3000);
+
+  for (uint32_t i = 0; i + 1 < original.numVertices(); ++i) {
+    original.addEdge(original.getVertexById(i), original.getVertexById(i + 1),
+                     i, i + 1, 2 * i);
+    original.addEdge(original.getVertexById(0), original.getVertexById(i + 1),
+                     i, i + 2, 3 * i);
+  }
+
+  Graph copy(original);
+
+  REQUIRE( copy.numVertices() == original.numVertices() );
+  REQUIRE( copy.getEdges().size() == original.getEdges().size() );
+
+  for (uint32_t id = 0; id < original.numVertices(); ++id) {
+    Vertex* u = original.getVertexById(id);
+    Vertex* v = copy.getVertexById(id);
+
+    REQUIRE( v != u );
+    REQUIRE( v->getAddress() == u->getAddress() );
+    REQUIRE( copy.getVertex(u->getAddress()) == v );
+    REQUIRE( v->getIncidentEdges().size() == u->getIncidentEdges().size() );
+
+    for (size_t i = 0; i < u->getIncidentEdges().size(); ++i) {
+      Edge* e = u->getIncidentEdges()[i];
+      Edge* f = v->getIncidentEdges()[i];
+      REQUIRE( f->getAdjacentVertex(v)->getId() == e->getAdjacentVertex(u)->getId() );
+      REQUIRE( f->getGas() == e->getGas() );
+    }
+  }
+
+  for (size_t i = 0; i < original.getEdges().size(); ++i) {
+    REQUIRE( copy.getEdges()[i]->getGasPrice() == original.getEdges()[i]->getGasPrice() );
+  }
+
+  // assigning over an existing graph frees its vertices and edges first
+  Graph assigned;
+  assigned.addEdge(assigned.addVertex("0xabc"), assigned.addVertex("0xdef"), 1, 1, 1);
+  assigned = copy;
+  REQUIRE( assigned.numVertices() == original.numVertices() );
+  REQUIRE( assigned.getVertex("0xabc") == NULL );
+}
+
+TEST_CASE("Connected components are tracked while a graph is loaded and grows", "[graph]") {
+  string contents = ",from_address,to_address,truncated_value,gas,gas_price\n";
+  for (int i = 0; i < 300; ++i) {
+    // three separate rings of 100 vertices each, plus a pair
+    int ring = i / 100;
+    contents += std::to_string(i) + ",0x" + std::to_string(1000 * (ring + 1) + i % 100)
+              + ",0x" + std::to_string(1000 * (ring + 1) + (i + 1) % 100) + ",1,1,1\n";
+  }
+  contents += "300,0xaa,0xbb,1,1,1\n";
+
+  string path = writeTemporaryCsv("components", contents);
+  int num_threads = GENERATE(1, 4);
+  Graph* g = Graph::fromFile(path, true, num_threads, true);
+
+  REQUIRE( g->tracksComponents() );
+  REQUIRE( g->numComponents() == 4 );
+  REQUIRE( g->getComponentSizes() == std::vector<uint32_t>({100, 100, 100, 2}) );
+  REQUIRE( g->getLargestComponent().size() == 100 );
+  REQUIRE( g->getLargestComponent()[0] == g->getVertex("0x1000") );
+  REQUIRE( g->getComponent(g->getVertex("0x1000")) == 
+           g->getComponent(g->getVertex("0x1099")) );
+  REQUIRE( g->getComponent(g->getVertex("0x1000")) != 
+           g->getComponent(g->getVertex("0x2000")) );
+
+  // appended transactions update the components as they are added
+  g->addEdge(g->getVertex("0x2050"), g->getVertex("0x3050"), 1, 1, 1);
+  g->addEdge(g->getVertex("0xbb"), g->addVertex("0xcc"), 1, 1, 1);
+  g->addVertex("0xdd");
+
+  REQUIRE( g->numComponents() == 4 );
+  REQUIRE( g->getComponentSizes() == std::vector<uint32_t>({100, 200, 3, 1}) );
+  REQUIRE( g->getComponentSize(g->getVertex("0x3000")) == 200 );
+  REQUIRE( g->getLargestComponent().size() == 200 );
+  REQUIRE( g->getLargestComponent()[0] == g->getVertex("0x2000") );
+
+  // copies keep tracking their own components
+  Graph copy(*g);
+  copy.addEdge(copy.getVertex("0x1000"), copy.getVertex("0xdd"), 1, 1, 1);
+  REQUIRE( copy.numComponents() == 3 );
+  REQUIRE( g->numComponents() == 4 );
+
+  delete g;
+  std::remove(path.c_str());
+}
+
+TEST_CASE("Tracking components of an existing graph", "[graph]") {
+  Graph g;
+  Vertex* a = g.addVertex("0x1");
+  Vertex* b = g.addVertex("0x2");
+  Vertex* c = g.addVertex("0x3");
+  g.addEdge(a, b, 1, 1, 1);
+
+  REQUIRE( !g.tracksComponents() );
+  g.trackComponents();
+
+  REQUIRE( g.numComponents() == 2 );
+  REQUIRE( g.getComponent(a) == g.getComponent(b) );
+  REQUIRE( g.getComponentSize(c) == 1 );
+
+  g.addEdge(c, b, 1, 1, 1);
+  REQUIRE( g.numComponents() == 1 );
+  REQUIRE( g.getLargestComponent().size() == 3 );
+}
@@ -0,0 +1,46 @@
+#pragma once
+#include <cstdint>
+#include <random>
+#include <string>
+
+#include "vertex.h"
+#include "graph.h"
+
+/**
+ * @brief Add n vertices named 0x1 to 0xn to the passed graph, which are given
+ * the IDs 0 to n - 1 if the graph was empty.
+ *
+ * @param g a Graph to add the vertices to.
+ * @param n an int indicating the number of vertices.
+ */
+inline void addVertices(Graph& g, int n) {
+  for (int i = 1; i <= n; ++i) {
+    g.addVertex("0x" + std::to_string(i));
+  }
+}
+
+/**
+ * @brief Fill the passed graph with n vertices named 0x1 to 0xn and m random
+ * edges, which may be parallel or self loops, between the first reachable
+ * vertices. The remaining vertices are left without edges. Every call with the
+ * same arguments builds the same graph.
+ *
+ * @param g an empty Graph to fill.
+ * @param n an int indicating the number of vertices.
+ * @param m an int indicating the number of edges.
+ * @param reachable an int indicating the number of vertices given edges.
+ * @param max_weight a uint64_t indicating the largest edge weight.
+ * @param min_weight a uint64_t indicating the smallest edge weight.
+ */
+inline void randomGraph(Graph& g, int n, int m, int reachable,
+                        uint64_t max_weight, uint64_t min_weight=1) {
+  std::mt19937 rng(225);
+  addVertices(g, n);
+
+  for (int i = 0; i < m; ++i) {
+    Vertex* source = g.getVertexById(rng() % reachable);
+    Vertex* destination = g.getVertexById(rng() % reachable);
+    uint64_t weight = min_weight + rng() % (max_weight - min_weight + 1);
+    g.addEdge(source, destination, 1, weight, 1);
+  }
+}
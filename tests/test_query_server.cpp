@@ -0,0 +1,219 @@
+#include "catch.hpp"
+#include "test_graphs.h"
+#include "query_server.h"
+#include "shortest_path.h"
+#include "csr_graph.h"
+#include "graph.h"
+
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+
+#include <fstream>
+#include <cstring>
+#include <cstdio>
+#include <string>
+#include <thread>
+#include <vector>
+
+using std::string;
+using std::vector;
+
+/**
+ * @brief A minimal client that connects to a QueryServer and sends it one
+ * request at a time.
+ */
+class TestClient {
+  public:
+    explicit TestClient(const string& path) : fd_(socket(AF_UNIX, SOCK_STREAM, 0)) {
+      sockaddr_un address;
+      memset(&address, 0, sizeof(address));
+      address.sun_family = AF_UNIX;
+      strncpy(address.sun_path, path.c_str(), sizeof(address.sun_path) - 1);
+
+      connected_ = connect(fd_, reinterpret_cast<sockaddr*>(&address), 
+                           sizeof(address)) == 0;
+    }
+
+    ~TestClient() { close(fd_); }
+
+    bool isConnected() const { return connected_; }
+
+    /**
+     * @brief Send the passed bytes as they are.
+     */
+    bool write(const string& bytes) {
+      return send(fd_, bytes.data(), bytes.size(), 0) == 
+             static_cast<ssize_t>(bytes.size());
+    }
+
+    /**
+     * @brief Wait for the next response line.
+     */
+    string response() {
+      string line;
+      char c;
+      while (recv(fd_, &c, 1, 0) == 1 && c != '\n') line += c;
+      return line;
+    }
+
+    /**
+     * @brief Send a request line and wait for its response line.
+     */
+    string request(const string& line) {
+      return write(line + "\n") ? response() : "";
+    }
+  private:
+    int fd_;
+    bool connected_;
+};
+
+TEST_CASE("QueryServer answers requests from concurrent local clients", "[server]") {
+  Graph g;
+  addVertices(g, 7);
+
+  // a path 0x1 - 0x2 - 0x3 - 0x4 with a shortcut, and a separate 0x5 - 0x6
+  g.addEdge(g.getVertex("0x1"), g.getVertex("0x2"), 1, 10, 1);
+  g.addEdge(g.getVertex("0x2"), g.getVertex("0x3"), 1, 10, 1);
+  g.addEdge(g.getVertex("0x3"), g.getVertex("0x4"), 1, 10, 1);
+  g.addEdge(g.getVertex("0x1"), g.getVertex("0x4"), 1, 50, 1);
+  g.addEdge(g.getVertex("0x5"), g.getVertex("0x6"), 1, 7, 1);
+
+  CSRGraph csr(g);
+  vector<double> centrality(csr.numVertices(), 0.0);
+  centrality[g.getVertex("0x2")->getId()] = 2.5;
+
+  QueryServer server(g, csr, centrality, 2);
+
+  string path = "tests/test_query_server.sock";
+  REQUIRE( server.listen(path) );
+  std::thread serving(&QueryServer::serve, &server);
+
+  {
+    TestClient first(path), second(path);
+    REQUIRE( first.isConnected() );
+    REQUIRE( second.isConnected() );
+
+    // both connections are served at once
+    REQUIRE( first.request("PING") == "OK pong" );
+    REQUIRE( second.request("PING") == "OK pong" );
+
+    REQUIRE( first.request("DIST 0x1 0x4") == "OK 30" );
+    REQUIRE( second.request("DIST 0x1 0x6") == "OK unreachable" );
+    // addresses in paths are written out in full
+    REQUIRE( first.request("PATH 0x1 0x3") == "OK 20 "
+             "0x0000000000000000000000000000000000000001 "
+             "0x0000000000000000000000000000000000000002 "
+             "0x0000000000000000000000000000000000000003" );
+    REQUIRE( second.request("BFS 0x1") == "OK 4 2" );
+    REQUIRE( first.request("COMPONENT 0x6") == 
+             second.request("COMPONENT 0x5") );
+
+    // 0x7 has no edges, so it is alone in its component
+    string isolated = first.request("COMPONENT 0x7");
+    REQUIRE( isolated.substr(0, 3) == "OK " );
+    REQUIRE( isolated.substr(isolated.size() - 2) == " 1" );
+    REQUIRE( second.request("CENTRALITY 0x2") == "OK 2.5" );
+    REQUIRE( first.request("DIST 0x1 0x99") == "ERR unknown address 0x99" );
+    REQUIRE( first.request("WALK 0x1") == "ERR unknown request WALK" );
+
+    REQUIRE( second.request("SHUTDOWN") == "OK shutting down" );
+  }
+
+  serving.join();
+  REQUIRE( access(path.c_str(), F_OK) != 0 );
+
+  // requests can also be answered without a socket
+  REQUIRE( server.answer("DIST 0x2 0x4") == "OK 20" );
+}
+
+TEST_CASE("QueryServer answers clients while more clients than workers are idle", "[server]") {
+  Graph g;
+  g.addEdge(g.addVertex("0x1"), g.addVertex("0x2"), 1, 10, 1);
+  g.addEdge(g.getVertex("0x2"), g.addVertex("0x3"), 1, 10, 1);
+
+  CSRGraph csr(g);
+  QueryServer server(g, csr, vector<double>(), 1);
+
+  string path = "tests/test_query_server_idle.sock";
+  REQUIRE( server.listen(path) );
+  std::thread serving(&QueryServer::serve, &server);
+
+  {
+    // a single worker, with three clients that never finish a request
+    TestClient idle(path), partial(path), quiet(path);
+    REQUIRE( idle.isConnected() );
+    REQUIRE( partial.write("DIST 0x1") );
+    REQUIRE( quiet.request("PING") == "OK pong" );
+
+    TestClient active(path);
+    REQUIRE( active.request("PING") == "OK pong" );
+    REQUIRE( active.request("DIST 0x1 0x3") == "OK 20" );
+
+    // requests sent together are answered in order
+    REQUIRE( active.write("DIST 0x1 0x2\nPING\nDIST 0x2 0x3\n") );
+    REQUIRE( active.response() == "OK 10" );
+    REQUIRE( active.response() == "OK pong" );
+    REQUIRE( active.response() == "OK 10" );
+
+    // the partial request is answered once its line is complete
+    REQUIRE( partial.request(" 0x2") == "OK 10" );
+
+    // QUIT closes only the connection that sent it
+    REQUIRE( quiet.write("QUIT\n") );
+    REQUIRE( quiet.response() == "" );
+    REQUIRE( active.request("PING") == "OK pong" );
+
+    REQUIRE( active.request("SHUTDOWN") == "OK shutting down" );
+  }
+
+  serving.join();
+  REQUIRE( access(path.c_str(), F_OK) != 0 );
+}
+
+TEST_CASE("QueryServer only replaces a socket left at its path", "[server]") {
+  Graph g;
+  g.addEdge(g.addVertex("0x1"), g.addVertex("0x2"), 1, 10, 1);
+
+  CSRGraph csr(g);
+  string path = "tests/test_query_server_stale.sock";
+
+  SECTION("A regular file at the path is kept") {
+    std::ofstream(path) << "address,centrality\n";
+
+    QueryServer server(g, csr, vector<double>(), 1);
+    REQUIRE( !server.listen(path) );
+
+    std::ifstream kept(path);
+    string line;
+    REQUIRE( std::getline(kept, line) );
+    REQUIRE( line == "address,centrality" );
+    std::remove(path.c_str());
+  }
+
+  SECTION("A socket left by an earlier server is replaced") {
+    {
+      // binding the socket and closing it without removing the file leaves it
+      // behind as if its server had crashed
+      int fd = socket(AF_UNIX, SOCK_STREAM, 0);
+      sockaddr_un address;
+      memset(&address, 0, sizeof(address));
+      address.sun_family = AF_UNIX;
+      memcpy(address.sun_path, path.c_str(), path.size());
+      REQUIRE( bind(fd, reinterpret_cast<sockaddr*>(&address),
+                    sizeof(address)) == 0 );
+      close(fd);
+    }
+
+    QueryServer server(g, csr, vector<double>(), 1);
+    REQUIRE( server.listen(path) );
+    std::thread serving(&QueryServer::serve, &server);
+
+    {
+      TestClient client(path);
+      REQUIRE( client.request("SHUTDOWN") == "OK shutting down" );
+    }
+
+    serving.join();
+  }
+}
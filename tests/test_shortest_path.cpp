@@ -0,0 +1,336 @@
+#include "catch.hpp"
+#include "test_graphs.h"
+#include "test_files.h"
+#include "batch_queries.h"
+#include "contraction_hierarchy.h"
+#include "shortest_path.h"
+#include "hop_labels.h"
+#include "landmarks.h"
+#include "snapshot.h"
+#include "dijkstras.h"
+#include "csr_graph.h"
+#include "workspace.h"
+#include "vertex.h"
+#include "graph.h"
+
+#include <cstddef>
+#include <cstdio>
+#include <functional>
+#include <random>
+#include <sstream>
+#include <string>
+#include <vector>
+
+using std::string;
+using std::vector;
+
+/**
+ * @brief Get the length of the passed path, or UNREACHED if two consecutive
+ * vertices of the path are not adjacent. The lightest edge between two 
+ * vertices is used if there are several.
+ */
+uint64_t pathLength(const CSRGraph& g, const vector<uint32_t>& path) {
+  uint64_t length = 0;
+
+  for (size_t i = 0; i + 1 < path.size(); ++i) {
+    uint64_t lightest = TraversalWorkspace::UNREACHED;
+
+    for (uint64_t j = g.offset(path[i]); j < g.offset(path[i] + 1); ++j) {
+      if (g.neighbor(j) == path[i + 1] && g.weight(j) < lightest) {
+        lightest = g.weight(j);
+      }
+    }
+
+    if (lightest == TraversalWorkspace::UNREACHED) return lightest;
+    length += lightest;
+  }
+
+  return length;
+}
+
+/**
+ * @brief Check the shortest paths returned by the passed query from a few
+ * sources to every 7th vertex against the distances found by Dijkstra's
+ * algorithm. Paths must run from the source to the target along edges of the
+ * graph and have the returned length, and unreachable targets must have empty
+ * paths.
+ *
+ * @param csr the CSRGraph the query searches.
+ * @param query a function returning the ShortestPath from its first argument
+ * to its second.
+ */
+void checkShortestPaths(
+    const CSRGraph& csr, 
+    const std::function<ShortestPath(uint32_t, uint32_t)>& query) {
+  TraversalWorkspace workspace(csr);
+
+  for (uint32_t source : {0u, 17u, 500u}) {
+    dijkstra(csr, source, workspace);
+
+    for (uint32_t target = 0; target < csr.numVertices(); target += 7) {
+      ShortestPath result = query(source, target);
+
+      REQUIRE( result.distance == workspace.getDistance(target) );
+
+      if (result.distance == TraversalWorkspace::UNREACHED) {
+        REQUIRE( result.path.empty() );
+      } else {
+        REQUIRE( result.path.front() == source );
+        REQUIRE( result.path.back() == target );
+        REQUIRE( pathLength(csr, result.path) == result.distance );
+      }
+    }
+  }
+}
+
+TEST_CASE("Bidirectional Dijkstra finds shortest paths between two vertices", "[shortest_path]") {
+  // the last 10 vertices are left unreachable
+  Graph g;
+  randomGraph(g, 1000, 3000, 990, 20);
+
+  CSRGraph csr(g);
+  TraversalWorkspace forward(csr), backward(csr);
+
+  checkShortestPaths(csr, [&](uint32_t source, uint32_t target) {
+    return shortest_path(csr, source, target, forward, backward);
+  });
+}
+
+TEST_CASE("Bidirectional Dijkstra settles few vertices on a long path", "[shortest_path]") {
+  Graph g;
+
+  addVertices(g, 10000);
+
+  for (uint32_t i = 0; i + 1 < g.numVertices(); ++i) {
+    g.addEdge(g.getVertexById(i), g.getVertexById(i + 1), 1, 3, 1);
+  }
+
+  CSRGraph csr(g);
+
+  ShortestPath result = shortest_path(csr, 5000, 5010);
+  REQUIRE( result.distance == 30 );
+  REQUIRE( result.path.size() == 11 );
+  REQUIRE( result.settled < 20 );
+
+  ShortestPath same = shortest_path(csr, 42, 42);
+  REQUIRE( same.distance == 0 );
+  REQUIRE( same.path == vector<uint32_t>{42} );
+}
+
+TEST_CASE("A* search with landmarks finds shortest paths", "[shortest_path]") {
+  Graph g;
+  randomGraph(g, 1000, 3000, 990, 20);
+
+  CSRGraph csr(g);
+  LandmarkIndex index = LandmarkIndex::build(csr, 4, 2);
+  REQUIRE( index.numLandmarks() == 4 );
+
+  // landmarks are saved next to the dataset and must load back unchanged
+  string path = "tests/test_landmarks.bin";
+  REQUIRE( index.save(path, csr) );
+
+  LandmarkIndex loaded;
+  REQUIRE( LandmarkIndex::load(path, csr, loaded) );
+  REQUIRE( loaded.numLandmarks() == 4 );
+
+  for (uint32_t i = 0; i < 4; ++i) {
+    REQUIRE( loaded.getLandmark(i) == index.getLandmark(i) );
+  }
+
+  // tables computed for another graph are rejected
+  CSRGraph other;
+  REQUIRE( !LandmarkIndex::load(path, other, loaded) );
+
+  // as are tables said to start past the end of the file
+  overwriteAt<uint32_t>(path, offsetof(LandmarkHeader, header_size),
+                        0xFFFFFFF8);
+  REQUIRE( !LandmarkIndex::load(path, csr, loaded) );
+
+  // or to overlap the header, or to be misaligned
+  overwriteAt<uint32_t>(path, offsetof(LandmarkHeader, header_size), 0);
+  REQUIRE( !LandmarkIndex::load(path, csr, loaded) );
+  overwriteAt<uint32_t>(path, offsetof(LandmarkHeader, header_size),
+                        sizeof(LandmarkHeader) + 4);
+  REQUIRE( !LandmarkIndex::load(path, csr, loaded) );
+  std::remove(path.c_str());
+
+  TraversalWorkspace search(csr);
+
+  checkShortestPaths(csr, [&](uint32_t source, uint32_t target) {
+    ShortestPath result = 
+      alt_shortest_path(csr, loaded, source, target, search);
+
+    // the distance is checked, so this bounds the true distance too
+    REQUIRE( loaded.lowerBound(source, target) <= result.distance );
+    return result;
+  });
+}
+
+TEST_CASE("Contraction hierarchies find shortest paths", "[shortest_path]") {
+  // parallel edges and self loops must not confuse the contraction
+  Graph g;
+  randomGraph(g, 1000, 3000, 990, 20);
+
+  // a hub of high degree is left in the core
+  for (int i = 1; i < 200; ++i) {
+    g.addEdge(g.getVertexById(0), g.getVertexById(i * 3), 1, 25, 1);
+  }
+
+  CSRGraph csr(g);
+  ContractionHierarchy built = ContractionHierarchy::build(csr, 2);
+  REQUIRE( built.numVertices() == csr.numVertices() );
+
+  string path = "tests/test_hierarchy.bin";
+  REQUIRE( built.save(path, csr) );
+
+  ContractionHierarchy hierarchy;
+  REQUIRE( ContractionHierarchy::load(path, csr, hierarchy) );
+  REQUIRE( hierarchy.numUpEdges() == built.numUpEdges() );
+
+  // a hierarchy built for another graph is rejected
+  CSRGraph other;
+  REQUIRE( !ContractionHierarchy::load(path, other, hierarchy) );
+
+  // as is one with more edges than the file holds, even where their size in
+  // bytes overflows
+  overwriteAt<uint64_t>(path, offsetof(HierarchyHeader, num_up_edges),
+                        uint64_t(1) << 62);
+  REQUIRE( !ContractionHierarchy::load(path, csr, hierarchy) );
+
+  // or one whose header overlaps its arrays
+  REQUIRE( built.save(path, csr) );
+  overwriteAt<uint32_t>(path, offsetof(HierarchyHeader, header_size), 0);
+  REQUIRE( !ContractionHierarchy::load(path, csr, hierarchy) );
+
+  // or one with a shortcut through its own endpoint, which would never finish
+  // unpacking
+  REQUIRE( built.save(path, csr) );
+  size_t n = csr.numVertices(), m = built.numUpEdges();
+  size_t targets = sizeof(HierarchyHeader) + snapshot_align(n * 4)
+                   + snapshot_align((n + 1) * 8);
+  size_t middles = targets + snapshot_align(m * 4);
+  size_t shortcut = 0;
+  while (shortcut < m && readAt<uint32_t>(path, middles + shortcut * 4) ==
+                         TraversalWorkspace::NO_VERTEX) {
+    ++shortcut;
+  }
+  REQUIRE( shortcut < m );
+  overwriteAt<uint32_t>(path, middles + shortcut * 4,
+                        readAt<uint32_t>(path, targets + shortcut * 4));
+  REQUIRE( !ContractionHierarchy::load(path, csr, hierarchy) );
+  std::remove(path.c_str());
+
+  TraversalWorkspace forward(csr), backward(csr);
+
+  checkShortestPaths(csr, [&](uint32_t source, uint32_t target) {
+    return hierarchy.query(source, target, forward, backward);
+  });
+}
+
+TEST_CASE("Hop labels give exact hop distances", "[shortest_path]") {
+  // every edge weighs 1, so Dijkstra's algorithm counts hops; the last 10 
+  // vertices are left unreachable
+  Graph g;
+  randomGraph(g, 1000, 3000, 990, 1);
+
+  CSRGraph csr(g);
+  HopLabeling sequential = HopLabeling::build(csr);
+  HopLabeling parallel = HopLabeling::build(csr, 3);
+
+  REQUIRE( sequential.numVertices() == csr.numVertices() );
+  REQUIRE( parallel.numVertices() == csr.numVertices() );
+  REQUIRE( sequential.memoryUsage() > 0 );
+
+  TraversalWorkspace workspace(csr);
+
+  for (uint32_t source : {0u, 17u, 500u, 995u}) {
+    dijkstra(csr, source, workspace);
+
+    for (uint32_t target = 0; target < csr.numVertices(); ++target) {
+      uint64_t expected = workspace.getDistance(target);
+      if (expected == TraversalWorkspace::UNREACHED) {
+        expected = HopLabeling::UNREACHED;
+      }
+
+      REQUIRE( sequential.query(source, target) == expected );
+      REQUIRE( parallel.query(source, target) == expected );
+    }
+  }
+}
+
+TEST_CASE("Batch queries are answered in input order on any number of threads", "[shortest_path]") {
+  // the address 0x301 has no transactions, so no other address reaches it
+  Graph g;
+  randomGraph(g, 301, 1000, 300, 20);
+  std::mt19937 rng(225);
+
+  CSRGraph csr(g);
+
+  string text = "# a comment\n"
+                "dist 0x1 0x2\n"
+                "\n"
+                "knn 0x5 3\n"
+                "sssp 0x7\n"
+                "dist 0x1 0xabc\n"
+                "knn 0x5 three\n"
+                "walk 0x1\n"
+                "dist 0x1 0x301\n";
+
+  for (int i = 0; i < 100; ++i) {
+    text += "dist 0x" + std::to_string(1 + rng() % 300) + " 0x" + 
+            std::to_string(1 + rng() % 300) + "\n";
+  }
+
+  std::istringstream in(text);
+  vector<BatchQuery> queries;
+  vector<string> errors;
+  parse_batch_queries(in, g, queries, errors);
+
+  REQUIRE( queries.size() == 104 );
+  REQUIRE( errors.size() == 3 );
+  REQUIRE( queries[0].line == 2 );
+  REQUIRE( queries[1].type == BatchQuery::Type::NEAREST );
+  REQUIRE( queries[1].k == 3 );
+
+  std::ostringstream sequential, parallel;
+  run_batch_queries(csr, queries, sequential, 1);
+  run_batch_queries(csr, queries, parallel, 3);
+  REQUIRE( sequential.str() == parallel.str() );
+
+  REQUIRE( sequential.str().find("\n9,0x0000000000000000000000000000000000000301,"
+                                "unreachable\n") != string::npos );
+
+  // every row holds the distance found by a full search from its source
+  std::istringstream rows(sequential.str());
+  string row;
+  std::getline(rows, row);
+  REQUIRE( row == "query,address,distance" );
+
+  TraversalWorkspace workspace(csr);
+  size_t nearest_rows = 0, last_line = 0;
+
+  while (std::getline(rows, row)) {
+    size_t first_comma = row.find(',');
+    size_t second_comma = row.find(',', first_comma + 1);
+    size_t line = std::stoul(row.substr(0, first_comma));
+    string address = row.substr(first_comma + 1, second_comma - first_comma - 1);
+    string field = row.substr(second_comma + 1);
+    uint64_t distance = field == UNREACHABLE_DISTANCE 
+      ? TraversalWorkspace::UNREACHED : std::stoull(field);
+
+    REQUIRE( line >= last_line );
+    last_line = line;
+
+    const BatchQuery* query = NULL;
+    for (const BatchQuery& q : queries) {
+      if (q.line == line) query = &q;
+    }
+    REQUIRE( query != NULL );
+
+    dijkstra(csr, query->source, workspace);
+    REQUIRE( workspace.getDistance(g.getVertex(address)->getId()) == distance );
+    if (query->type == BatchQuery::Type::NEAREST) ++nearest_rows;
+  }
+
+  REQUIRE( nearest_rows == 3 );
+}